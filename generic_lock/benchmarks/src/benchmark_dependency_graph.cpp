@@ -0,0 +1,122 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Benchmark Dependency Graph
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <generic_lock/details/dependency_graph.hpp>
+
+using namespace gl::details;
+
+namespace {
+
+// Number of dependencies per transaction in the generated graphs.
+constexpr size_t dependencies_per_transaction = 2;
+
+/**
+ * @brief Generate an acyclic dependency graph between the given number of
+ * transactions. Each transaction depends on randomly selected transactions
+ * with smaller identifiers. The dependencies are added in random order so that
+ * the incremental topological order of the graph gets exercised.
+ *
+ * @param graph Reference to the dependency graph.
+ * @param transactions_count The number of transactions.
+ */
+void GenerateAcyclicGraph(DependencyGraph<size_t>& graph,
+                          size_t transactions_count) {
+  std::mt19937 generator(transactions_count);
+  std::vector<std::pair<size_t, size_t>> dependencies;
+  for (size_t id = 1; id < transactions_count; ++id) {
+    for (size_t i = 0; i < dependencies_per_transaction; ++i) {
+      dependencies.emplace_back(id, generator() % id);
+    }
+  }
+  std::shuffle(dependencies.begin(), dependencies.end(), generator);
+  for (auto& dependency : dependencies) {
+    graph.Add(dependency.first, dependency.second);
+  }
+}
+
+/**
+ * @brief Generate random dependencies, not already existing in the given
+ * graph, used for insertion in the benchmarks.
+ *
+ * @param graph Reference to the dependency graph.
+ * @param transactions_count The number of transactions.
+ * @returns Vector of dependencies.
+ */
+std::vector<std::pair<size_t, size_t>> GenerateDependencies(
+    DependencyGraph<size_t>& graph, size_t transactions_count) {
+  std::mt19937 generator(transactions_count + 1);
+  std::vector<std::pair<size_t, size_t>> dependencies(1024);
+  for (auto& dependency : dependencies) {
+    do {
+      dependency.first = generator() % transactions_count;
+      dependency.second = generator() % transactions_count;
+    } while (graph.IsDependent(dependency.first, dependency.second));
+  }
+  return dependencies;
+}
+
+}  // namespace
+
+/**
+ * @brief Measures insertion of a dependency followed by a full cycle search
+ * starting from the dependent transaction.
+ *
+ */
+static void BM_AddThenDetectCycle(benchmark::State& state) {
+  DependencyGraph<size_t> graph;
+  GenerateAcyclicGraph(graph, state.range(0));
+  auto dependencies = GenerateDependencies(graph, state.range(0));
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto& dependency = dependencies[i++ % dependencies.size()];
+    graph.Add(dependency.first, dependency.second);
+    benchmark::DoNotOptimize(graph.DetectCycle(dependency.first));
+    graph.Remove(dependency.first, dependency.second);
+  }
+}
+BENCHMARK(BM_AddThenDetectCycle)->Arg(10000)->Arg(100000);
+
+/**
+ * @brief Measures insertion of a dependency with incremental cycle detection.
+ * The full cycle search is only run when the insertion closes a cycle.
+ *
+ */
+static void BM_AddIncremental(benchmark::State& state) {
+  DependencyGraph<size_t> graph;
+  GenerateAcyclicGraph(graph, state.range(0));
+  auto dependencies = GenerateDependencies(graph, state.range(0));
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto& dependency = dependencies[i++ % dependencies.size()];
+    if (graph.Add(dependency.first, dependency.second)) {
+      benchmark::DoNotOptimize(graph.DetectCycle(dependency.first));
+    }
+    graph.Remove(dependency.first, dependency.second);
+  }
+}
+BENCHMARK(BM_AddIncremental)->Arg(10000)->Arg(100000);
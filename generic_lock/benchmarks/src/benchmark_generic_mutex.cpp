@@ -0,0 +1,80 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Benchmark Generic Mutex
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <generic_lock/generic_mutex.hpp>
+
+using namespace gl;
+
+namespace {
+
+typedef size_t RecordId;
+typedef size_t TransactionId;
+enum class LockMode { READ, WRITE };
+const ContentionMatrix<2> contention_matrix = {
+    {{{false, true}}, {{true, true}}}};
+
+// Number of records locked by each thread per iteration.
+constexpr size_t records_per_thread = 64;
+
+/**
+ * @brief Measures the throughput of uncontended lock and unlock operations with
+ * increasing number of threads. Each thread operates on its own disjoint set of
+ * records so that the only source of contention is the latch protecting the
+ * lock table.
+ *
+ * @tparam shards_count The number of lock table shards.
+ */
+template <size_t shards_count>
+void BM_LockUnlockThreadScaling(benchmark::State& state) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, 300,
+                       SelectMaxPolicy<TransactionId>, shards_count>
+      GenericMutexType;
+  static GenericMutexType* mutex = nullptr;
+  if (state.thread_index() == 0) {
+    mutex = new GenericMutexType(contention_matrix);
+  }
+
+  const TransactionId transaction_id = state.thread_index();
+  const RecordId first_record_id = transaction_id * records_per_thread;
+  for (auto _ : state) {
+    for (size_t i = 0; i < records_per_thread; ++i) {
+      benchmark::DoNotOptimize(
+          mutex->Lock(first_record_id + i, transaction_id, LockMode::WRITE));
+    }
+    for (size_t i = 0; i < records_per_thread; ++i) {
+      mutex->Unlock(first_record_id + i, transaction_id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * records_per_thread);
+
+  if (state.thread_index() == 0) {
+    delete mutex;
+  }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_LockUnlockThreadScaling, 1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockUnlockThreadScaling, 64)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
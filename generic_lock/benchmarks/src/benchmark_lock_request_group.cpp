@@ -0,0 +1,55 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Benchmark Lock Request Group
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <generic_lock/details/lock_request_group.hpp>
+
+using namespace gl::details;
+
+namespace {
+
+typedef size_t TransactionId;
+enum class LockMode { READ, WRITE };
+const ContentionMatrix<2> contention_matrix = {
+    {{{false, true}}, {{true, true}}}};
+const ContentionTable<2> contention_table(contention_matrix);
+
+/**
+ * @brief Measures emplacement of a read request into a group already holding
+ * the given number of read requests, as happens on a hot record.
+ *
+ */
+void BM_EmplaceIntoReaderGroup(benchmark::State& state) {
+  LockRequestGroup<TransactionId, LockMode, 2> group;
+  const TransactionId readers_count = state.range(0);
+  for (TransactionId id = 0; id < readers_count; ++id) {
+    group.EmplaceLockRequest(id, LockMode::READ, contention_table);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(group.EmplaceLockRequest(
+        readers_count, LockMode::READ, contention_table));
+    group.RemoveLockRequest(readers_count);
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BM_EmplaceIntoReaderGroup)->Arg(10)->Arg(5000);
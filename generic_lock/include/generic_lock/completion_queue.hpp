@@ -0,0 +1,182 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__COMPLETION_QUEUE_HPP
+#define GENERIC_LOCK__COMPLETION_QUEUE_HPP
+
+// The completion queue is signalled through an eventfd, which is only
+// available on Linux. Nothing is defined on other platforms.
+#if __has_include(<sys/eventfd.h>)
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace gl {
+
+/**
+ * @brief Completion queue collects the outcomes of lock requests made on a
+ * generic mutex without blocking, so that a single event loop thread can drive
+ * many lock requests at once. Requests are submitted through the queue, and
+ * each request granted or denied is pushed to the queue as a completion. The
+ * queue is signalled through an eventfd whenever completions become available,
+ * which can be registered with `epoll` or any other readiness based event
+ * loop.
+ *
+ * @example
+ * gl::CompletionQueue<MutexType> queue(mutex);
+ * queue.Lock(record_id, transaction_id, LockMode::READ);
+ * // Register `queue.FileDescriptor()` for `EPOLLIN`, and once readable:
+ * for (auto& completion : queue.Poll()) { ... }
+ *
+ * @note The queue should outlive all the lock requests submitted through it.
+ *
+ * @tparam GenericMutex The type of generic mutex.
+ */
+template <class GenericMutex>
+class CompletionQueue {
+  typedef typename GenericMutex::record_id_t record_id_t;
+  typedef typename GenericMutex::lock_mode_t lock_mode_t;
+  typedef typename GenericMutex::transaction_id_t transaction_id_t;
+
+ public:
+  /**
+   * @brief Outcome of a lock request submitted through the queue.
+   *
+   */
+  struct Completion {
+    record_id_t record_id;
+    transaction_id_t transaction_id;
+    lock_mode_t mode;
+    bool granted;
+  };
+
+  /**
+   * @brief Construct a new Completion Queue object.
+   *
+   * @param generic_mutex Reference to the generic mutex to lock.
+   * @throws std::system_error if the eventfd could not be created.
+   */
+  explicit CompletionQueue(GenericMutex& generic_mutex)
+      : generic_mutex_ptr_(&generic_mutex),
+        fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (fd_ < 0) {
+      throw std::system_error(errno, std::system_category(),
+                              "CompletionQueue: eventfd creation failed");
+    }
+  }
+
+  /**
+   * @brief Destroy the Completion Queue object. The eventfd is closed.
+   *
+   */
+  ~CompletionQueue() { close(fd_); }
+
+  // Queue not copyable
+  CompletionQueue(const CompletionQueue& other) = delete;
+  // Queue not copy assignable
+  CompletionQueue& operator=(const CompletionQueue& other) = delete;
+
+  /**
+   * @brief Submit a lock request on a record with the given identifier without
+   * blocking. The outcome of the request is pushed to the queue once the
+   * request is granted or denied, which can happen during the call itself.
+   *
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   */
+  void Lock(const record_id_t& record_id,
+            const transaction_id_t& transaction_id, const lock_mode_t& mode) {
+    generic_mutex_ptr_->LockAsync(
+        record_id, transaction_id, mode,
+        [this, record_id, transaction_id, mode](bool granted) noexcept {
+          Push(Completion{record_id, transaction_id, mode, granted});
+        });
+  }
+
+  /**
+   * @brief Get the eventfd signalled when completions are available. The file
+   * descriptor is non-blocking and becomes readable once the queue is not
+   * empty. It is reset by polling the queue.
+   *
+   * @returns The eventfd file descriptor.
+   */
+  int FileDescriptor() const { return fd_; }
+
+  /**
+   * @brief Remove all the available completions from the queue, resetting the
+   * eventfd. Completions pushed during the call are either returned or signal
+   * the eventfd again.
+   *
+   * @returns The completions in the order they were pushed.
+   */
+  std::vector<Completion> Poll() {
+    // The eventfd is reset before taking the completions so that a completion
+    // pushed in between is never left behind without a signal.
+    uint64_t count;
+    while (read(fd_, &count, sizeof(count)) < 0 && errno == EINTR) {
+    }
+    std::vector<Completion> completions;
+    LockGuard guard(latch_);
+    completions.swap(completions_);
+    return completions;
+  }
+
+ private:
+  // Guard type.
+  typedef std::lock_guard<std::mutex> LockGuard;
+
+  /**
+   * @brief Push the given completion to the queue. The eventfd is signalled
+   * only when the queue turns non-empty, saving a system call per completion.
+   * The completion is pushed from the release path of the mutex, so nothing is
+   * thrown. A write failing with `EAGAIN` leaves the eventfd signalled anyway,
+   * while the other failures can not occur on a valid eventfd.
+   *
+   * @param completion Rvalue reference to the completion.
+   */
+  void Push(Completion&& completion) noexcept {
+    bool was_empty;
+    {
+      LockGuard guard(latch_);
+      was_empty = completions_.empty();
+      completions_.push_back(std::move(completion));
+    }
+    if (was_empty) {
+      uint64_t count = 1;
+      while (write(fd_, &count, sizeof(count)) < 0 && errno == EINTR) {
+      }
+    }
+  }
+
+  GenericMutex* generic_mutex_ptr_;
+  // Eventfd signalled when completions are available.
+  int fd_;
+  // Latch for atomic modification of the completions.
+  std::mutex latch_;
+  // Completions yet to be polled.
+  std::vector<Completion> completions_;
+};
+
+}  // namespace gl
+
+#endif
+
+#endif /* GENERIC_LOCK__COMPLETION_QUEUE_HPP */
@@ -0,0 +1,92 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__CONTENTION_POLICY_HPP
+#define GENERIC_LOCK__CONTENTION_POLICY_HPP
+
+#include <generic_lock/details/contention_matrix.hpp>
+
+namespace gl {
+
+/**
+ * @brief This policy takes the contention matrix at runtime, passed to the
+ * constructor of the mutex. The matrix is converted to contention and
+ * conversion tables stored within the mutex.
+ *
+ */
+struct RuntimeContentionPolicy {};
+
+/**
+ * @brief This policy takes the contention matrix at compile time. The
+ * contention and conversion tables are built at compile time, so that
+ * contention checks against them can be inlined and constant folded. The mutex
+ * is then default constructed.
+ *
+ * @tparam modes_count The number of lock modes.
+ * @tparam contention_matrix Constant reference to the contention matrix with
+ * static storage duration.
+ */
+template <size_t modes_count,
+          const details::ContentionMatrix<modes_count>& contention_matrix>
+struct StaticContentionPolicy {
+  static constexpr details::ContentionTable<modes_count> contention_table{
+      contention_matrix};
+  static constexpr details::ConversionTable<modes_count> conversion_table{
+      contention_matrix};
+};
+
+/**
+ * @brief Contention matrix of a read-write lock with lock modes `READ = 0` and
+ * `WRITE = 1`.
+ *
+ */
+inline constexpr details::ContentionMatrix<2> read_write_contention_matrix = {{
+    // READ, WRITE
+    {{false, true}},  // READ
+    {{true, true}}    // WRITE
+}};
+
+/**
+ * @brief Contention matrix of a multigranularity lock with lock modes
+ * `INTENTION_SHARED = 0`, `INTENTION_EXCLUSIVE = 1`, `SHARED = 2`,
+ * `SHARED_INTENTION_EXCLUSIVE = 3` and `EXCLUSIVE = 4`.
+ *
+ */
+inline constexpr details::ContentionMatrix<5>
+    multigranularity_contention_matrix = {{
+        // IS, IX, S, SIX, X
+        {{false, false, false, false, true}},  // IS
+        {{false, false, true, true, true}},    // IX
+        {{false, true, false, true, true}},    // S
+        {{false, true, true, true, true}},     // SIX
+        {{true, true, true, true, true}}       // X
+    }};
+
+/**
+ * @brief Compile time contention policy of a read-write lock.
+ *
+ */
+typedef StaticContentionPolicy<2, read_write_contention_matrix>
+    ReadWriteContentionPolicy;
+
+/**
+ * @brief Compile time contention policy of a multigranularity lock.
+ *
+ */
+typedef StaticContentionPolicy<5, multigranularity_contention_matrix>
+    MultigranularityContentionPolicy;
+
+}  // namespace gl
+
+#endif /* GENERIC_LOCK__CONTENTION_POLICY_HPP */
@@ -0,0 +1,93 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__DEADLOCK_POLICY_HPP
+#define GENERIC_LOCK__DEADLOCK_POLICY_HPP
+
+namespace gl {
+
+/**
+ * @brief This policy detects deadlocks lazily. A waiting transaction checks for
+ * presence of a deadlock each time its wait times out. Deadlocks are thus
+ * discovered at least one timeout after their formation.
+ *
+ */
+struct DetectOnTimeoutPolicy {};
+
+/**
+ * @brief This policy detects deadlocks eagerly. A transaction checks for
+ * presence of a deadlock as soon as it is put into wait mode, i.e. right after
+ * its dependencies are inserted into the dependency graph. Since a cycle can
+ * only be formed by the insertion of new dependencies, all deadlocks are
+ * discovered at the moment they are formed, and recovered from by denying
+ * requests till no cycle is left. A deadlock whose recovery is cut short, as a
+ * victim stops waiting while it is being denied, is left to the periodic
+ * deadlock checks of the waiting transactions, which back up the eager
+ * detection.
+ *
+ */
+struct DetectOnWaitPolicy {};
+
+/**
+ * @brief This policy detects deadlocks in a dedicated background thread. The
+ * thread periodically searches the entire dependency graph and recovers from
+ * all the discovered deadlocks, waking up only the transactions whose requests
+ * are denied. Waiting transactions thus block till their request is either
+ * granted or denied, without running any deadlock checks themselves.
+ *
+ */
+struct DetectInBackgroundPolicy {};
+
+/**
+ * @brief This policy prevents deadlocks by never waiting. A lock request which
+ * cannot be granted right away is denied. No dependency graph is maintained.
+ *
+ */
+struct NoWaitPolicy {};
+
+/**
+ * @brief This policy prevents deadlocks using the wait-die scheme. A
+ * transaction is only allowed to wait on transactions younger than itself. A
+ * lock request which would wait on an older transaction is denied right away,
+ * i.e. the requesting transaction dies. No dependency graph is maintained.
+ *
+ * @note The age of a transaction is given by its identifier, with smaller
+ * identifiers being older. The transaction identifier type should thus support
+ * the `<` operator. An aborted transaction should be restarted with its
+ * original identifier in order to avoid starvation.
+ *
+ */
+struct WaitDiePolicy {};
+
+/**
+ * @brief This policy prevents deadlocks using the wound-wait scheme. A
+ * transaction is only allowed to wait on transactions older than itself. When
+ * a lock request would wait on younger transactions, they are wounded instead.
+ * A wounded transaction waiting on a lock has its request denied right away,
+ * while one holding a lock is aborted at its next lock request. The requesting
+ * transaction then waits till the wounded transactions release their locks.
+ * The wound is dropped once a wounded transaction releases all its locks, so
+ * that its identifier can be reused. No dependency graph is maintained.
+ *
+ * @note The age of a transaction is given by its identifier, with smaller
+ * identifiers being older. The transaction identifier type should thus support
+ * the `<` operator. An aborted transaction should be restarted with its
+ * original identifier in order to avoid starvation.
+ *
+ */
+struct WoundWaitPolicy {};
+
+}  // namespace gl
+
+#endif /* GENERIC_LOCK__DEADLOCK_POLICY_HPP */
@@ -202,6 +202,81 @@ class ConditionVariable {
     return _cv.wait_for(lock, duration, std::move(stop_waiting));
   }
 
+  /**
+   * WaitUntil causes the current thread to block until the condition variable
+   * is notified, a specified deadline is reached, or a spurious wakeup occurs.
+   * When unblocked, regardless of the reason, lock is reacquired and the
+   * predicate is checked. Until the predicate is satisfied (`!stop_waiting() ==
+   * true`), the thread waits again.
+   *
+   * @tparam Clock The clock type of the deadline.
+   * @tparam Duration The duration type of the deadline.
+   * @tparam Predicate The predicate type.
+   * @param lock Reference to the unique lock which can be locked by the current
+   * thread.
+   * @param deadline Constant reference to an object of type
+   * `std::chrono::time_point` representing the time when to stop waiting.
+   * @param stop_waiting The predicate which returns ​false if the waiting
+   * should be continued. The signature of the predicate function should be
+   * equivalent to `bool stop_waiting();`.
+   * @returns `false` if the predicate `stop_waiting` still evaluates to `false`
+   * after the deadline is reached, otherwise `true`.
+   */
+  template <class Clock, class Duration, class Predicate>
+  bool WaitUntil(std::unique_lock<std::mutex>& lock,
+                 const std::chrono::time_point<Clock, Duration>& deadline,
+                 Predicate stop_waiting) {
+    return _cv.wait_until(lock, deadline, std::move(stop_waiting));
+  }
+
+  /**
+   * WaitUntil causes the current thread to block until the condition variable
+   * is notified, a specified deadline is reached, or a spurious wakeup occurs.
+   * While blocking it periodically unblocks the thread and executes a specified
+   * callback, as long as the deadline is not reached. When unblocked,
+   * regardless of the reason, lock is reacquired and the predicate is checked.
+   * Until the predicate is satisfied (`!stop_waiting() == true`), the thread
+   * waits again.
+   *
+   * @tparam Clock The clock type of the deadline.
+   * @tparam Duration The duration type of the deadline.
+   * @tparam Rep An arithmetic type representing the number of ticks.
+   * @tparam Period A ratio representing tick period.
+   * @tparam Callback The callback type.
+   * @tparam Predicate The predicate type.
+   * @param lock Reference to the unique lock which can be locked by the current
+   * thread.
+   * @param deadline Constant reference to an object of type
+   * `std::chrono::time_point` representing the time when to stop waiting.
+   * @param duration Constant reference to an object of type
+   * `std::chrono::duration` representing the time interval between the
+   * periodical execution of the callback.
+   * @param callback The callback executed periodically. The signature of the
+   * callback function should be equivalent to `void callback();`.
+   * @param stop_waiting The predicate which returns ​false if the waiting
+   * should be continued. The signature of the predicate function should be
+   * equivalent to `bool stop_waiting();`.
+   * @returns `false` if the predicate `stop_waiting` still evaluates to `false`
+   * after the deadline is reached, otherwise `true`.
+   */
+  template <class Clock, class Duration, class Rep, class Period,
+            class Callback, class Predicate>
+  bool WaitUntil(std::unique_lock<std::mutex>& lock,
+                 const std::chrono::time_point<Clock, Duration>& deadline,
+                 const std::chrono::duration<Rep, Period>& duration,
+                 Callback callback, Predicate stop_waiting) {
+    while (!stop_waiting()) {
+      auto wakeup = Clock::now() + duration;
+      if (!(wakeup < deadline)) {
+        return _cv.wait_until(lock, deadline, std::move(stop_waiting));
+      }
+      if (_cv.wait_until(lock, wakeup) == std::cv_status::timeout) {
+        callback();
+      }
+    }
+    return true;
+  }
+
   /**
    * Unblocks all threads currently waiting on the condition variable.
    *
@@ -16,6 +16,7 @@
 #define GENERIC_LOCK__DETAILS__CONTENTION_MATRIX_HPP
 
 #include <array>
+#include <cstdint>
 
 namespace gl {
 namespace details {
@@ -39,6 +40,167 @@ namespace details {
 template <size_t modes_count>
 using ContentionMatrix = std::array<std::array<bool, modes_count>, modes_count>;
 
+/**
+ * Bitmask of lock modes. The bit at the position given by the integer value of
+ * a lock mode is set if the mode is part of the mask.
+ *
+ */
+typedef uint64_t LockModeMask;
+
+/**
+ * Contention table stores the contention matrix as a bitmask row for each lock
+ * mode, marking the modes contending with it. Contention of a requested mode
+ * with a set of lock modes is thus checked using a single bitwise operation.
+ * The table can be built at compile time from a constant contention matrix.
+ *
+ * @tparam modes_count The number of lock modes.
+ */
+template <size_t modes_count>
+class ContentionTable {
+  static_assert(modes_count <= 64, "At most 64 lock modes are supported.");
+
+ public:
+  /**
+   * Construct a new Contention Table object from the given contention matrix.
+   *
+   * @param contention_matrix Constant reference to the contention matrix.
+   */
+  constexpr ContentionTable(
+      const ContentionMatrix<modes_count>& contention_matrix)
+      : _rows() {
+    for (size_t held = 0; held < modes_count; ++held) {
+      for (size_t requested = 0; requested < modes_count; ++requested) {
+        if (contention_matrix[held][requested]) {
+          _rows[requested] |= LockModeMask(1) << held;
+        }
+      }
+    }
+  }
+
+  /**
+   * Get the bitmask containing only the given lock mode.
+   *
+   * @tparam LockMode Lock mode type.
+   * @param mode Constant reference to the lock mode.
+   * @returns Bitmask of the lock mode.
+   */
+  template <class LockMode>
+  static constexpr LockModeMask Mask(const LockMode& mode) {
+    return LockModeMask(1) << size_t(mode);
+  }
+
+  /**
+   * Check if the requested lock mode contends with any of the given modes.
+   *
+   * @tparam LockMode Lock mode type.
+   * @param modes Constant reference to the bitmask of lock modes.
+   * @param mode Constant reference to the requested lock mode.
+   * @returns `true` if there is contention else `false`.
+   */
+  template <class LockMode>
+  constexpr bool Contends(const LockModeMask& modes,
+                          const LockMode& mode) const {
+    return (_rows[size_t(mode)] & modes) != 0;
+  }
+
+ private:
+  // Bitmask of the contending lock modes for each requested lock mode.
+  std::array<LockModeMask, modes_count> _rows;
+};
+
+/**
+ * Conversion table stores the supremum of each pair of lock modes, i.e. the
+ * weakest lock mode covering both. A mode covers another if it contends with
+ * every mode the other contends with, both as a held and as a requested mode.
+ * The table is derived from the contention matrix and is used to convert the
+ * lock held by a transaction into a lock also covering the newly requested
+ * mode. Pairs of modes not covered by any single mode have no supremum.
+ *
+ * @tparam modes_count The number of lock modes.
+ */
+template <size_t modes_count>
+class ConversionTable {
+  static_assert(modes_count <= 64, "At most 64 lock modes are supported.");
+
+ public:
+  // Value used in place of the lock mode for pairs having no supremum
+  static constexpr size_t null_mode = modes_count;
+
+  /**
+   * Construct a new Conversion Table object from the given contention matrix.
+   *
+   * @param contention_matrix Constant reference to the contention matrix.
+   */
+  constexpr ConversionTable(
+      const ContentionMatrix<modes_count>& contention_matrix)
+      : _supremums() {
+    // Modes contending with each mode when requested and when held.
+    std::array<LockModeMask, modes_count> requested_rows{}, held_rows{};
+    for (size_t held = 0; held < modes_count; ++held) {
+      for (size_t requested = 0; requested < modes_count; ++requested) {
+        if (contention_matrix[held][requested]) {
+          requested_rows[requested] |= LockModeMask(1) << held;
+          held_rows[held] |= LockModeMask(1) << requested;
+        }
+      }
+    }
+    for (size_t a = 0; a < modes_count; ++a) {
+      for (size_t b = 0; b < modes_count; ++b) {
+        auto requested_row = requested_rows[a] | requested_rows[b];
+        auto held_row = held_rows[a] | held_rows[b];
+        size_t supremum = null_mode, supremum_contentions = 0;
+        for (size_t mode = 0; mode < modes_count; ++mode) {
+          if ((requested_rows[mode] & requested_row) != requested_row ||
+              (held_rows[mode] & held_row) != held_row) {
+            continue;
+          }
+          // The covering mode with the fewest contentions is the weakest.
+          auto contentions =
+              Count(requested_rows[mode]) + Count(held_rows[mode]);
+          if (supremum == null_mode || contentions < supremum_contentions) {
+            supremum = mode;
+            supremum_contentions = contentions;
+          }
+        }
+        _supremums[a][b] = uint8_t(supremum);
+      }
+    }
+  }
+
+  /**
+   * Get the supremum of the given lock modes.
+   *
+   * @tparam LockMode Lock mode type.
+   * @param held Constant reference to the held lock mode.
+   * @param requested Constant reference to the requested lock mode.
+   * @returns Integer value of the supremum lock mode, or `null_mode` if the
+   * modes have no supremum.
+   */
+  template <class LockMode>
+  constexpr size_t Supremum(const LockMode& held,
+                            const LockMode& requested) const {
+    return _supremums[size_t(held)][size_t(requested)];
+  }
+
+ private:
+  /**
+   * Count the lock modes in the given bitmask.
+   *
+   * @param modes Constant reference to the bitmask of lock modes.
+   * @returns Number of lock modes in the bitmask.
+   */
+  static constexpr size_t Count(const LockModeMask& modes) {
+    size_t count = 0;
+    for (auto _modes = modes; _modes != 0; _modes &= _modes - 1) {
+      ++count;
+    }
+    return count;
+  }
+
+  // Supremum of each pair of lock modes
+  std::array<std::array<uint8_t, modes_count>, modes_count> _supremums;
+};
+
 }  // namespace details
 }  // namespace gl
 
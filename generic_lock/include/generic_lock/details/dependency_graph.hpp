@@ -15,8 +15,13 @@
 #ifndef GENERIC_LOCK__DETAILS__DEPENDENCY_GRAPH_HPP
 #define GENERIC_LOCK__DETAILS__DEPENDENCY_GRAPH_HPP
 
-#include <set>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <generic_lock/details/small_vector.hpp>
+#include <iterator>
 #include <unordered_map>
+#include <vector>
 
 namespace gl {
 namespace details {
@@ -26,12 +31,119 @@ namespace details {
  * transactions. A transaction `A` is dependent on transaction `B` if `A` is
  * waiting to access a shared data which is currently locked by `B`.
  *
+ * The graph incrementally maintains a topological order of its nodes using the
+ * Pearce-Kelly algorithm. When a dependency is added against the order, only
+ * the nodes whose position lies between those of the two ends of the
+ * dependency are searched and reordered. A cycle is thus discovered the moment
+ * the dependency closing it is added, with a cost proportional to the affected
+ * region of the graph. Such a dependency is recorded as unordered since no
+ * topological order exists while the cycle is present. The unordered
+ * dependencies are ordered again once the cycles containing them are broken
+ * through removal of dependencies. Every cycle in the graph contains at least
+ * one unordered dependency, and vice versa.
+ *
+ * Each node is stored in a dense slot of a vector so that an identifier is
+ * hashed only when looking up its node. The dependency edges of a node, along
+ * with the reverse edges pointing to it, are stored as slot indices in small
+ * inline vectors. Slots of removed nodes are reused by the nodes added later.
+ *
  * @tparam TransactionId Transaction identifier type.
  * @tparam Hash The type of hash function object for thread identifier.
  */
 template <class TransactionId, class Hash = std::hash<TransactionId>>
 class DependencyGraph {
+  // Index of the slot containing a node.
+  typedef uint32_t NodeSlot;
+
+  // Dependency edge to a node along with a flag indicating if the edge is in
+  // agreement with the topological order.
+  struct Edge {
+    NodeSlot node;
+    bool ordered;
+  };
+
+  // List of dependency edges of a node. Most nodes have only a few edges which
+  // are thus stored inline.
+  typedef SmallVector<Edge, 4> EdgeList;
+
+  // Node of the dependency graph.
+  struct Node {
+    Node(const TransactionId& id, size_t order)
+        : id(id), order(order), out_edges(), in_edges() {}
+
+    // Identifier of the thread.
+    TransactionId id;
+    // Position of the node in the topological order.
+    size_t order;
+    // Edges to the nodes on which the node depends.
+    EdgeList out_edges;
+    // Edges from the nodes dependent on the node.
+    EdgeList in_edges;
+  };
+
  public:
+  /**
+   * Non-owning view of the identifiers of threads forming a cycle in the
+   * dependency graph. The view refers to the scratch space of the graph, thus
+   * no allocation is made when reporting a cycle. It exposes the standard
+   * container interface so that it can be used with the standard algorithms
+   * and the selection policies.
+   *
+   */
+  class CycleView {
+   public:
+    /**
+     * Constant forward iterator over the identifiers in the cycle.
+     *
+     */
+    class Iterator {
+     public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef TransactionId value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const TransactionId* pointer;
+      typedef const TransactionId& reference;
+
+      Iterator(const Node* nodes, const NodeSlot* slot)
+          : _nodes(nodes), _slot(slot) {}
+
+      reference operator*() const { return _nodes[*_slot].id; }
+      pointer operator->() const { return &_nodes[*_slot].id; }
+      Iterator& operator++() {
+        ++_slot;
+        return *this;
+      }
+      Iterator operator++(int) {
+        auto rvalue = *this;
+        ++_slot;
+        return rvalue;
+      }
+      bool operator==(const Iterator& other) const {
+        return _slot == other._slot;
+      }
+      bool operator!=(const Iterator& other) const {
+        return _slot != other._slot;
+      }
+
+     private:
+      const Node* _nodes;
+      const NodeSlot* _slot;
+    };
+
+    CycleView(const Node* nodes, const NodeSlot* begin, const NodeSlot* end)
+        : _nodes(nodes), _begin(begin), _end(end) {}
+
+    Iterator begin() const { return Iterator(_nodes, _begin); }
+    Iterator end() const { return Iterator(_nodes, _end); }
+    size_t size() const { return _end - _begin; }
+    bool empty() const { return _begin == _end; }
+
+   private:
+    const Node* _nodes;
+    const NodeSlot* _begin;
+    const NodeSlot* _end;
+  };
+
   /**
    * Construct a new Dependency Graph object.
    *
@@ -40,13 +152,30 @@ class DependencyGraph {
 
   /**
    * Add dependency from thread with identifier `id_a` to that with identifier
-   * `id_b`.
+   * `id_b`. The method reports if the added dependency closes a cycle in the
+   * graph.
    *
    * @param id_a Constant reference to the identifier of the dependent thread.
    * @param id_b Constant reference to the identifier of the depended thread.
+   * @returns `true` if the dependency closes a cycle else `false`.
    */
-  void Add(const TransactionId& id_a, const TransactionId& id_b) {
-    _dependency_map[id_a][id_b] = true;
+  bool Add(const TransactionId& id_a, const TransactionId& id_b) {
+    auto slot_a = InsertNode(id_a);
+    auto slot_b = InsertNode(id_b);
+    auto& out_edges = _nodes[slot_a].out_edges;
+    if (FindEdge(out_edges, slot_b) != out_edges.End()) {
+      // Dependency already exists
+      return false;
+    }
+
+    bool ordered = Reorder(slot_a, slot_b);
+    out_edges.PushBack({slot_b, ordered});
+    _nodes[slot_b].in_edges.PushBack({slot_a, ordered});
+    if (!ordered) {
+      _unordered_dependencies.emplace_back(slot_a, slot_b);
+    }
+
+    return !ordered;
   }
 
   /**
@@ -58,29 +187,89 @@ class DependencyGraph {
    */
   void Remove(const TransactionId& id_a, const TransactionId& id_b) {
     // Removes dependency edge only if it exists
-    auto it = _dependency_map.find(id_a);
-    if (it != _dependency_map.end()) {
-      it->second.erase(id_b);
-      // Removes element from graph if no more dependency edges exist
-      if (it->second.empty()) {
-        _dependency_map.erase(it);
+    auto index_a = _index.find(id_a);
+    auto index_b = _index.find(id_b);
+    if (index_a == _index.end() || index_b == _index.end()) {
+      return;
+    }
+    auto slot_a = index_a->second;
+    auto slot_b = index_b->second;
+    auto& out_edges = _nodes[slot_a].out_edges;
+    auto edge_it = FindEdge(out_edges, slot_b);
+    if (edge_it == out_edges.End()) {
+      return;
+    }
+    bool ordered = edge_it->ordered;
+    out_edges.Erase(edge_it);
+    auto& in_edges = _nodes[slot_b].in_edges;
+    in_edges.Erase(FindEdge(in_edges, slot_a));
+
+    if (!ordered) {
+      for (auto it = _unordered_dependencies.begin();
+           it != _unordered_dependencies.end(); ++it) {
+        if (it->first == slot_a && it->second == slot_b) {
+          _unordered_dependencies.erase(it);
+          break;
+        }
       }
     }
+    // Removes nodes from graph if no more dependency edges exist
+    EraseNodeIfIsolated(slot_a);
+    EraseNodeIfIsolated(slot_b);
+    RestoreOrder();
   }
 
   /**
-   * Remove all dependencies for thread with the given identifier.
+   * Remove all dependencies for thread with the given identifier. This is an
+   * operation linear in the number of dependencies of the thread.
    *
    * @param id Constant reference to the thread identifier.
    */
   void Remove(const TransactionId& id) {
+    auto index_it = _index.find(id);
+    if (index_it == _index.end()) {
+      return;
+    }
+    auto slot = index_it->second;
+
     // Erase all dependency edges for the given transaction identifier
-    for (auto& element : _dependency_map) {
-      element.second.erase(id);
+    auto& node = _nodes[slot];
+    for (auto edge = node.out_edges.Begin(); edge != node.out_edges.End();
+         ++edge) {
+      auto& in_edges = _nodes[edge->node].in_edges;
+      in_edges.Erase(FindEdge(in_edges, slot));
+      if (edge->node != slot) {
+        EraseNodeIfIsolated(edge->node);
+      }
+    }
+    node.out_edges.Clear();
+    for (auto edge = node.in_edges.Begin(); edge != node.in_edges.End();
+         ++edge) {
+      auto& out_edges = _nodes[edge->node].out_edges;
+      out_edges.Erase(FindEdge(out_edges, slot));
+      EraseNodeIfIsolated(edge->node);
+    }
+    node.in_edges.Clear();
+
+    for (auto it = _unordered_dependencies.begin();
+         it != _unordered_dependencies.end();) {
+      if (it->first == slot || it->second == slot) {
+        it = _unordered_dependencies.erase(it);
+      } else {
+        ++it;
+      }
     }
-    _dependency_map.erase(id);
+    EraseNodeIfIsolated(slot);
+    RestoreOrder();
   }
 
+  /**
+   * Check if the dependency graph contains a cycle. This is an O(1) operation.
+   *
+   * @returns `true` if a cycle exists else `false`.
+   */
+  bool HasCycle() const { return !_unordered_dependencies.empty(); }
+
   /**
    * Check if a thread with identifier `id_a` is depenedent on a thread with
    * identifier `id_b`.
@@ -90,145 +279,324 @@ class DependencyGraph {
    * @returns `true` if the thread is dependent else `false`.
    */
   bool IsDependent(const TransactionId& id_a, const TransactionId& id_b) {
-    auto it = _dependency_map.find(id_a);
-    if (it != _dependency_map.end()) {
-      return it->second.find(id_b) != it->second.end();
+    auto index_a = _index.find(id_a);
+    auto index_b = _index.find(id_b);
+    if (index_a != _index.end() && index_b != _index.end()) {
+      auto& out_edges = _nodes[index_a->second].out_edges;
+      return FindEdge(out_edges, index_b->second) != out_edges.End();
     }
     return false;
   }
 
   /**
    * Detects a cycle in the dependency graph starting lookup from the given
-   * identifier. The method returns the set of identifiers forming the cycle. If
-   * the set is empty then no cycle was observed.
+   * identifier. The method returns a view of the identifiers forming the
+   * cycle. If the view is empty then no cycle was observed.
+   *
+   * @note The returned view is invalidated by the next modification of the
+   * graph or cycle detection.
    *
    * @param id Constant reference to the thread identifier from where to start
-   * lookup. This identifier should exist in the dependency graph.
-   * @returns Set of thread identifiers forming a cycle in the dependency graph.
-   */
-  std::set<TransactionId> DetectCycle(const TransactionId& id) const {
-    std::unordered_map<TransactionId, TransactionId> parents;
-    std::unordered_map<TransactionId, bool> visited;
-    std::set<TransactionId> rvalue;
-
-    auto result = DetectCycle(id, parents, visited);
-    if (result.second) {
-      rvalue.insert(result.first);
-      auto node = parents.at(result.first);
-      while (node != result.first) {
-        rvalue.insert(node);
-        node = parents.at(node);
-      }
+   * lookup.
+   * @returns View of thread identifiers forming a cycle in the dependency
+   * graph.
+   */
+  CycleView DetectCycle(const TransactionId& id) {
+    _cycle.clear();
+    auto index_it = _index.find(id);
+    if (index_it != _index.end()) {
+      auto visiting = ++_mark;
+      auto visited = ++_mark;
+      DetectCycle(index_it->second, visiting, visited);
     }
+    return GetCycle();
+  }
 
-    return rvalue;
+  /**
+   * Detects a cycle anywhere in the dependency graph. The lookup is started
+   * from each node not visited by the prior lookups. The method returns a view
+   * of the identifiers forming the first observed cycle. If the view is empty
+   * then the dependency graph contains no cycle.
+   *
+   * @note The returned view is invalidated by the next modification of the
+   * graph or cycle detection.
+   *
+   * @returns View of thread identifiers forming a cycle in the dependency
+   * graph.
+   */
+  CycleView DetectCycle() {
+    _cycle.clear();
+    auto visiting = ++_mark;
+    auto visited = ++_mark;
+    for (NodeSlot slot = 0; slot < _nodes.size() && _cycle.empty(); ++slot) {
+      auto mark = _marks[slot];
+      if (mark != visiting && mark != visited) {
+        DetectCycle(slot, visiting, visited);
+      }
+    }
+    return GetCycle();
   }
 
  private:
+  // Entry in the path of the depth first search containing the slot of the
+  // node along with the index of its next dependency edge to traverse.
+  struct PathEntry {
+    NodeSlot node;
+    uint32_t edge;
+  };
+
   /**
-   * The method starts traversing the dependency graph using breath first search
-   * algorithm through recursion. It marks each node as either "visited",
-   * "visiting", or "not-visited". A cycle is observed when we reach a
-   * "visiting" node again during our transversal. The path taken during the
-   * transversal can be obtained from the `partents` map, storing the parent
-   * node of each node traveled.
-   *
-   * @param node Constent reference to the node being transversed.
-   * @param parents Reference to the map storing immediate parents of each node
-   * transversed.
-   * @param visited Reference to the map storing visit status of each node.
-   * @returns A pair containing a flag indicating if a cycle was observed and
-   * the identifier on which the cycle was observed or null.
-   */
-  std::pair<TransactionId, bool> DetectCycle(
-      const TransactionId& node,
-      std::unordered_map<TransactionId, TransactionId>& parents,
-      std::unordered_map<TransactionId, bool>& visited) const {
-    // Current node is being observed for the first time so mark it as
-    // in the process of being visited.
-    visited[node] = false;
-
-    // Find cycles in the connected child nodes
-    auto it = _dependency_map.find(node);
-    if (it != _dependency_map.end()) {
-      for (auto& element : it->second) {
-        auto result = DetectCycle(element.first, node, parents, visited);
-        if (result.second) {
-          // Found cycle so stop transversal.
-          return result;
+   * Find the edge to the node in the given slot.
+   *
+   * @param edges Reference to the list of edges.
+   * @param slot The slot of the node.
+   * @returns Iterator pointing to the edge or to the end of the list.
+   */
+  static typename EdgeList::Iterator FindEdge(EdgeList& edges, NodeSlot slot) {
+    return std::find_if(edges.Begin(), edges.End(),
+                        [slot](const Edge& edge) { return edge.node == slot; });
+  }
+
+  /**
+   * Insert a node for the given identifier if it does not exist. The new node
+   * is placed at the end of the topological order.
+   *
+   * @param id Constant reference to the thread identifier.
+   * @returns The slot of the node.
+   */
+  NodeSlot InsertNode(const TransactionId& id) {
+    auto index_it = _index.find(id);
+    if (index_it != _index.end()) {
+      return index_it->second;
+    }
+    NodeSlot slot;
+    if (_free_slots.empty()) {
+      slot = _nodes.size();
+      _nodes.emplace_back(id, _next_order++);
+      _marks.push_back(0);
+    } else {
+      slot = _free_slots.back();
+      _free_slots.pop_back();
+      _nodes[slot].id = id;
+      _nodes[slot].order = _next_order++;
+    }
+    _index.emplace(id, slot);
+    return slot;
+  }
+
+  /**
+   * Erase the node in the given slot if it has no dependency edges. The slot is
+   * then free to be reused.
+   *
+   * @param slot The slot of the node.
+   */
+  void EraseNodeIfIsolated(NodeSlot slot) {
+    auto& node = _nodes[slot];
+    if (node.out_edges.Empty() && node.in_edges.Empty() &&
+        _index.erase(node.id) > 0) {
+      _free_slots.push_back(slot);
+    }
+  }
+
+  /**
+   * Update the topological order for a dependency from the node in slot
+   * `slot_a` to that in slot `slot_b`. Only the ordered dependencies are
+   * transversed. The nodes reachable from `slot_b` and placed before `slot_a`,
+   * and the nodes reaching `slot_a` and placed after `slot_b` are searched. The
+   * found nodes are then reassigned the same set of positions such that the
+   * later are placed before the former. No reordering is performed if `slot_a`
+   * is reachable from `slot_b` as the dependency closes a cycle.
+   *
+   * @param slot_a The slot of the dependent node.
+   * @param slot_b The slot of the depended node.
+   * @returns `true` if the dependency is in agreement with the updated order,
+   * or `false` if it closes a cycle.
+   */
+  bool Reorder(NodeSlot slot_a, NodeSlot slot_b) {
+    if (slot_a == slot_b) {
+      return false;
+    }
+    auto lower_bound = _nodes[slot_b].order;
+    auto upper_bound = _nodes[slot_a].order;
+    if (upper_bound < lower_bound) {
+      // Dependency already in agreement with the order
+      return true;
+    }
+
+    auto mark = ++_mark;
+    _forward.clear();
+    _backward.clear();
+
+    // Forward search from `slot_b`
+    _marks[slot_b] = mark;
+    _stack.push_back(slot_b);
+    while (!_stack.empty()) {
+      auto slot = _stack.back();
+      _stack.pop_back();
+      _forward.push_back(slot);
+      auto& out_edges = _nodes[slot].out_edges;
+      for (auto edge = out_edges.Begin(); edge != out_edges.End(); ++edge) {
+        if (!edge->ordered) {
+          continue;
+        }
+        if (edge->node == slot_a) {
+          // Found cycle so stop search.
+          _stack.clear();
+          return false;
+        }
+        if (_nodes[edge->node].order < upper_bound &&
+            _marks[edge->node] != mark) {
+          _marks[edge->node] = mark;
+          _stack.push_back(edge->node);
         }
       }
     }
 
-    // Mark the current node as completely visited.
-    visited[node] = true;
+    // Backward search from `slot_a`
+    _marks[slot_a] = mark;
+    _stack.push_back(slot_a);
+    while (!_stack.empty()) {
+      auto slot = _stack.back();
+      _stack.pop_back();
+      _backward.push_back(slot);
+      auto& in_edges = _nodes[slot].in_edges;
+      for (auto edge = in_edges.Begin(); edge != in_edges.End(); ++edge) {
+        if (!edge->ordered) {
+          continue;
+        }
+        if (_nodes[edge->node].order > lower_bound &&
+            _marks[edge->node] != mark) {
+          _marks[edge->node] = mark;
+          _stack.push_back(edge->node);
+        }
+      }
+    }
 
-    // No cycle detected.
-    return {{}, false};
+    // Reassign the positions of the searched nodes such that the nodes found in
+    // the backward search are placed before those found in the forward search.
+    auto by_order = [this](NodeSlot x, NodeSlot y) {
+      return _nodes[x].order < _nodes[y].order;
+    };
+    std::sort(_forward.begin(), _forward.end(), by_order);
+    std::sort(_backward.begin(), _backward.end(), by_order);
+    _positions.clear();
+    for (auto slot : _backward) {
+      _positions.push_back(_nodes[slot].order);
+    }
+    for (auto slot : _forward) {
+      _positions.push_back(_nodes[slot].order);
+    }
+    std::sort(_positions.begin(), _positions.end());
+    auto position_it = _positions.begin();
+    for (auto slot : _backward) {
+      _nodes[slot].order = *position_it++;
+    }
+    for (auto slot : _forward) {
+      _nodes[slot].order = *position_it++;
+    }
+
+    return true;
   }
 
   /**
-   * The method traverses the dependency graph using breath first search
-   * algorithm through recursion. It marks each node as either "visited",
-   * "visiting", or "not-visited". A cycle is observed when we reach a
-   * "visiting" node again during our transversal. The path taken during the
-   * transversal can be obtained from the `partents` map, storing the parent
-   * node of each node traveled.
-   *
-   * @param node Constent reference to the node being transversed.
-   * @param parent Constant referene to the immediate parent node previously
-   * transversed.
-   * @param parents Reference to the map storing immediate parents of each node
-   * transversed.
-   * @param visited Reference to the map storing visit status of each node.
-   * @returns A pair containing a flag indicating if a cycle was observed and
-   * the identifier on which the cycle was observed or null.
-   */
-  std::pair<TransactionId, bool> DetectCycle(
-      const TransactionId& node, const TransactionId& parent,
-      std::unordered_map<TransactionId, TransactionId>& parents,
-      std::unordered_map<TransactionId, bool>& visited) const {
-    // Set the parent node of the current node.
-    parents[node] = parent;
-
-    // Check if the current node has already been visited.
-    auto visited_it = visited.find(node);
-    if (visited_it != visited.end()) {
-      // Node visited before so return if its already completely visited.
-      if (visited_it->second) {
-        return {{}, false};
+   * Try to order the unordered dependencies. A dependency gets ordered once all
+   * the cycles it closed are broken.
+   *
+   */
+  void RestoreOrder() {
+    for (auto it = _unordered_dependencies.begin();
+         it != _unordered_dependencies.end();) {
+      if (Reorder(it->first, it->second)) {
+        auto& out_edges = _nodes[it->first].out_edges;
+        FindEdge(out_edges, it->second)->ordered = true;
+        auto& in_edges = _nodes[it->second].in_edges;
+        FindEdge(in_edges, it->first)->ordered = true;
+        it = _unordered_dependencies.erase(it);
+      } else {
+        ++it;
       }
-      // Node not completely visited so we have a cycle.
-      return {node, true};
     }
+  }
+
+  /**
+   * Get a view of the identifiers forming the cycle found by the last lookup.
+   *
+   * @returns View of thread identifiers forming the cycle.
+   */
+  CycleView GetCycle() const {
+    return CycleView(_nodes.data(), _cycle.data(),
+                     _cycle.data() + _cycle.size());
+  }
 
+  /**
+   * The method traverses the dependency graph using depth first search
+   * algorithm with an explicit stack of the nodes in the current path. It
+   * marks each node as either "visited", "visiting", or "not-visited". A cycle
+   * is observed when we reach a "visiting" node again during our transversal.
+   * The nodes in the path starting from the reached node then form the cycle
+   * and are copied to the cycle buffer.
+   *
+   * @param slot The slot of the node from where to start transversal.
+   * @param visiting Mark of the nodes in the process of being visited.
+   * @param visited Mark of the completely visited nodes.
+   */
+  void DetectCycle(NodeSlot slot, size_t visiting, size_t visited) {
     // Current node is being observed for the first time so mark it as
     // in the process of being visited.
-    visited[node] = false;
-
-    // Find cycles in the connected child nodes
-    auto it = _dependency_map.find(node);
-    if (it != _dependency_map.end()) {
-      for (auto& element : it->second) {
-        auto result = DetectCycle(element.first, node, parents, visited);
-        if (result.second) {
-          // Found cycle so stop transversal.
-          return result;
-        }
-      }
-    }
+    _marks[slot] = visiting;
+    _path.push_back({slot, 0});
 
-    // Mark the current node as completely visited.
-    visited[node] = true;
+    while (!_path.empty()) {
+      auto& entry = _path.back();
+      auto& out_edges = _nodes[entry.node].out_edges;
+      if (entry.edge == out_edges.Size()) {
+        // Mark the current node as completely visited.
+        _marks[entry.node] = visited;
+        _path.pop_back();
+        continue;
+      }
 
-    // No cycle detected yet.
-    return {{}, false};
+      auto child = out_edges[entry.edge++].node;
+      auto& mark = _marks[child];
+      if (mark == visiting) {
+        // Child node not completely visited so we have a cycle.
+        auto it = _path.end();
+        do {
+          --it;
+          _cycle.push_back(it->node);
+        } while (it->node != child);
+        // Found cycle so stop transversal.
+        _path.clear();
+        return;
+      }
+      if (mark != visited) {
+        mark = visiting;
+        _path.push_back({child, 0});
+      }
+    }
   }
 
-  // Dependency map
-  std::unordered_map<TransactionId, std::unordered_map<TransactionId, bool>,
-                     Hash>
-      _dependency_map;
+  // Nodes of the graph stored in dense slots
+  std::vector<Node> _nodes;
+  // Slots of the removed nodes available for reuse
+  std::vector<NodeSlot> _free_slots;
+  // Map of thread identifiers to the slots of their nodes
+  std::unordered_map<TransactionId, NodeSlot, Hash> _index;
+  // Position assigned to the next inserted node
+  size_t _next_order = 0;
+  // Dependencies closing cycles in the graph
+  std::vector<std::pair<NodeSlot, NodeSlot>> _unordered_dependencies;
+  // Identifier of the last search visiting each node, stored apart from the
+  // nodes for compactness
+  std::vector<size_t> _marks;
+  // Identifier of the last search through the graph
+  size_t _mark = 0;
+  // Scratch space reused by the searches for reordering nodes
+  std::vector<NodeSlot> _stack, _forward, _backward;
+  std::vector<size_t> _positions;
+  // Scratch space reused by the searches for cycles
+  std::vector<PathEntry> _path;
+  std::vector<NodeSlot> _cycle;
 };
 
 }  // namespace details
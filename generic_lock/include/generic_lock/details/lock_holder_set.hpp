@@ -0,0 +1,256 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__DETAILS__LOCK_HOLDER_SET_HPP
+#define GENERIC_LOCK__DETAILS__LOCK_HOLDER_SET_HPP
+
+#include <generic_lock/details/contention_matrix.hpp>
+#include <generic_lock/details/small_vector.hpp>
+#include <utility>
+
+namespace gl {
+namespace details {
+
+/**
+ * Set of transactions holding a lock on an uncontended record, along with
+ * their lock modes and the number of times they acquired the lock. It is a
+ * lightweight alternative to the lock request queue for records on which no
+ * transaction waits. The holders are stored inline and their lock modes are
+ * summarized in a single bitmask, so that compatible requests are granted
+ * without any heap allocation. The set holds at most `capacity` transactions,
+ * keeping the linear lookups of transactions cheap.
+ *
+ * @tparam TransactionId Transaction identifier type.
+ * @tparam LockMode Lock mode type.
+ * @tparam modes_count Number of lock modes.
+ * @tparam capacity Maximum number of holders in the set.
+ */
+template <class TransactionId, class LockMode, size_t modes_count,
+          size_t capacity>
+class LockHolderSet {
+ public:
+  // Holding transaction identifier along with its lock mode and the number of
+  // times the lock is acquired by the transaction.
+  struct LockHolder {
+    TransactionId transaction_id;
+    LockMode mode;
+    size_t hold_count;
+  };
+  typedef typename SmallVector<LockHolder, capacity>::ConstIterator
+      ConstIterator;
+
+  /**
+   * Construct a new Lock Holder Set object.
+   *
+   */
+  LockHolderSet() : _holders(), _modes(0) {}
+
+  /**
+   * Emplace a holder into the set if the set is not full, the transaction is
+   * not holding the lock already, and the lock mode does not contend with the
+   * lock modes of the existing holders.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param contention_table Constant reference to the contention table.
+   * @returns `true` on success else `false`.
+   */
+  bool EmplaceHolder(const TransactionId& transaction_id, const LockMode& mode,
+                     const ContentionTable<modes_count>& contention_table) {
+    if (_holders.Size() == capacity || Contends(mode, contention_table) ||
+        Find(transaction_id)) {
+      return false;
+    }
+    _holders.PushBack(LockHolder{transaction_id, mode, 1});
+    _modes |= ContentionTable<modes_count>::Mask(mode);
+    return true;
+  }
+
+  /**
+   * Check if the given lock mode contends with the lock modes of the holders.
+   *
+   * @param mode Constant reference to the lock mode.
+   * @param contention_table Constant reference to the contention table.
+   * @returns `true` if there is contention else `false`.
+   */
+  bool Contends(const LockMode& mode,
+                const ContentionTable<modes_count>& contention_table) const {
+    return contention_table.Contends(_modes, mode);
+  }
+
+  /**
+   * Remove the holder with the given transaction identifier from the set.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the holder is removed, `false` if no such holder exists.
+   */
+  bool RemoveHolder(const TransactionId& transaction_id) {
+    auto holder = Find(transaction_id);
+    if (!holder) {
+      return false;
+    }
+    Erase(holder);
+    return true;
+  }
+
+  /**
+   * Acquire the lock held by the holder with the given transaction identifier
+   * once more, incrementing its hold count.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` on success, `false` if no such holder exists.
+   */
+  bool AddHold(const TransactionId& transaction_id) {
+    auto holder = Find(transaction_id);
+    if (!holder) {
+      return false;
+    }
+    ++holder->hold_count;
+    return true;
+  }
+
+  /**
+   * Release the lock held by the holder with the given transaction identifier
+   * once, decrementing its hold count. The holder is removed from the set once
+   * the count drops to zero.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the holder is removed, `false` if it still holds the
+   * lock or no such holder exists.
+   */
+  bool ReleaseHold(const TransactionId& transaction_id) {
+    auto holder = Find(transaction_id);
+    if (!holder || --holder->hold_count > 0) {
+      return false;
+    }
+    Erase(holder);
+    return true;
+  }
+
+  /**
+   * Convert the lock mode of the holder with the given transaction identifier
+   * to the given lock mode if the mode does not contend with the lock modes of
+   * the other holders.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode to convert to.
+   * @param contention_table Constant reference to the contention table.
+   * @returns `true` on success, `false` on contention or if no such holder
+   * exists.
+   */
+  bool ConvertHolder(const TransactionId& transaction_id, const LockMode& mode,
+                     const ContentionTable<modes_count>& contention_table) {
+    auto holder = Find(transaction_id);
+    if (!holder) {
+      return false;
+    }
+    LockModeMask modes = 0;
+    for (auto it = _holders.Begin(); it != _holders.End(); ++it) {
+      if (it != holder) {
+        modes |= ContentionTable<modes_count>::Mask(it->mode);
+      }
+    }
+    if (contention_table.Contends(modes, mode)) {
+      return false;
+    }
+    holder->mode = mode;
+    _modes = modes | ContentionTable<modes_count>::Mask(mode);
+    return true;
+  }
+
+  /**
+   * Find the holder with the given transaction identifier.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns Constant pointer to the holder if found else `nullptr`.
+   */
+  const LockHolder* FindHolder(const TransactionId& transaction_id) const {
+    for (auto it = _holders.Begin(); it != _holders.End(); ++it) {
+      if (it->transaction_id == transaction_id) {
+        return it;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Remove all the holders from the set.
+   *
+   */
+  void Clear() {
+    _holders.Clear();
+    _modes = 0;
+  }
+
+  /**
+   * Get the number of holders in the set.
+   *
+   * @returns Number of holders in the set.
+   */
+  size_t Size() const { return _holders.Size(); }
+
+  /**
+   * Check if the set is empty.
+   *
+   * @returns `true` if empty else `false`.
+   */
+  bool Empty() const { return _holders.Empty(); }
+
+  /**
+   * Get a constant iterator pointing to the begining of the container.
+   *
+   * @return Constant iterator pointing to the begining of the container.
+   */
+  ConstIterator Begin() const { return _holders.Begin(); }
+
+  /**
+   * Get a constant iterator pointing to the end of the container.
+   *
+   * @returns Constant iterator pointing to the end of the container.
+   */
+  ConstIterator End() const { return _holders.End(); }
+
+ private:
+  /**
+   * Find the holder with the given transaction identifier.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns Pointer to the holder if found else `nullptr`.
+   */
+  LockHolder* Find(const TransactionId& transaction_id) {
+    return const_cast<LockHolder*>(FindHolder(transaction_id));
+  }
+
+  /**
+   * Erase the given holder from the set.
+   *
+   * @param holder Pointer to the holder.
+   */
+  void Erase(LockHolder* holder) {
+    _holders.Erase(holder);
+    // Only a handful of holders exist, so the bitmask is simply recomputed.
+    _modes = 0;
+    for (auto it = _holders.Begin(); it != _holders.End(); ++it) {
+      _modes |= ContentionTable<modes_count>::Mask(it->mode);
+    }
+  }
+
+  SmallVector<LockHolder, capacity> _holders;
+  LockModeMask _modes;
+};
+
+}  // namespace details
+}  // namespace gl
+
+#endif /* GENERIC_LOCK__DETAILS__LOCK_HOLDER_SET_HPP */
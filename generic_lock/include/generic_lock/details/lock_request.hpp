@@ -15,12 +15,16 @@
 #ifndef GENERIC_LOCK__DETAILS__LOCK_REQUEST_HPP
 #define GENERIC_LOCK__DETAILS__LOCK_REQUEST_HPP
 
+#include <cstddef>
+
 namespace gl {
 namespace details {
 
 /**
  * Lock request contains the type of lock mode requested and if the request is
- * denied due to deadlock discorvery.
+ * denied due to deadlock discorvery. A granted request might also have a
+ * pending conversion to another lock mode, and counts the number of times the
+ * lock is acquired by its transaction.
  *
  * @tparam LockMode Lock mode type.
  */
@@ -32,7 +36,12 @@ class LockRequest {
    *
    * @param mode Constant reference to the lock mode.
    */
-  LockRequest(const LockMode& mode) : mode_(mode), denied_(false) {}
+  LockRequest(const LockMode& mode)
+      : mode_(mode),
+        conversion_mode_(mode),
+        hold_count_(1),
+        denied_(false),
+        converting_(false) {}
 
   /**
    * Get the requested lock mode.
@@ -67,12 +76,76 @@ class LockRequest {
    */
   bool IsDenied() const { return denied_; }
 
+  /**
+   * Start the conversion of the granted lock request to the given lock mode.
+   *
+   * @param mode Constant reference to the lock mode to convert to.
+   */
+  void BeginConversion(const LockMode& mode) {
+    conversion_mode_ = mode;
+    converting_ = true;
+  }
+
+  /**
+   * End the pending conversion of the lock request, whether it succeeded or
+   * not.
+   *
+   */
+  void EndConversion() { converting_ = false; }
+
+  /**
+   * Check if the lock request has a pending conversion.
+   *
+   * @returns `true` if a conversion is pending else `false`.
+   */
+  bool IsConverting() const { return converting_; }
+
+  /**
+   * Get the lock mode of the pending conversion.
+   *
+   * @returns Constant reference to the lock mode to convert to.
+   */
+  const LockMode& GetConversionMode() const { return conversion_mode_; }
+
+  /**
+   * Acquire the granted lock once more, incrementing the hold count.
+   *
+   */
+  void AddHold() { ++hold_count_; }
+
+  /**
+   * Release the granted lock once, decrementing the hold count.
+   *
+   * @returns The number of times the lock is still held.
+   */
+  size_t ReleaseHold() { return --hold_count_; }
+
+  /**
+   * Set the number of times the lock is held.
+   *
+   * @param hold_count The hold count.
+   */
+  void SetHoldCount(size_t hold_count) { hold_count_ = hold_count; }
+
+  /**
+   * Get the number of times the lock is held.
+   *
+   * @returns The hold count.
+   */
+  size_t GetHoldCount() const { return hold_count_; }
+
  private:
   // The lock mode requested.
   LockMode mode_;
+  // The lock mode of the last conversion.
+  LockMode conversion_mode_;
+  // Number of times the lock is acquired by the transaction.
+  size_t hold_count_;
   // Flag indicating if the request should be denied. This is set to true if
   // the request causes a deadlock.
   bool denied_;
+  // Flag indicating if a conversion of the granted request is pending.
+  bool converting_;
 };
 
 }  // namespace details
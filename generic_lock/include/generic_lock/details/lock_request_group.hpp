@@ -15,6 +15,7 @@
 #ifndef GENERIC_LOCK__DETAILS__LOCK_REQUEST_GROUP_HPP
 #define GENERIC_LOCK__DETAILS__LOCK_REQUEST_GROUP_HPP
 
+#include <array>
 #include <generic_lock/details/contention_matrix.hpp>
 #include <generic_lock/details/indexed_list.hpp>
 #include <generic_lock/details/lock_request.hpp>
@@ -24,7 +25,13 @@ namespace details {
 
 /**
  * Group of lock request that are in agreement with each other such that all the
- * requests in the group can be granted simultaneously.
+ * requests in the group can be granted simultaneously. The group keeps count of
+ * its requests not in a denied state for each lock mode, along with a bitmask
+ * of the modes having such requests. Contention of a new request is thus
+ * checked using a single bitwise operation irrespective of the number of
+ * requests in the group. No new request joins the group while the conversion
+ * of a request in it is pending, so that conversions are granted ahead of
+ * requests made after them.
  *
  * @tparam TransactionId Transaction identifier type.
  * @tparam LockMode Lock mode type.
@@ -42,39 +49,53 @@ class LockRequestGroup {
    * Construct a new Lock Request Group object
    *
    */
-  LockRequestGroup() = default;
+  LockRequestGroup()
+      : _requests(), _mode_counts(), _modes(0), _conversions_count(0) {}
 
   /**
-   * Emplace a lock request into the group if there is no contention. The
-   * contention matrix is used to check for contention with any of the existing
-   * requests in the group. If a contention is found then the method returns
-   * `false, otherwise `true` is returned after emplacement.
+   * Emplace a lock request into the group if there is no contention and no
+   * conversion is pending. The contention table is used to check for
+   * contention with the lock modes of the existing requests in the group. If a
+   * contention is found then the method returns `false, otherwise `true` is
+   * returned after emplacement.
    *
    * @param transaction_id Constant reference to the transaction identifier.
    * @param mode Constant reference to the lock mode.
-   * @param contention_matrix Constant reference to the contention matrix.
+   * @param contention_table Constant reference to the contention table.
    * @returns `true` on success else `false`.
    */
   bool EmplaceLockRequest(
       const TransactionId& transaction_id, const LockMode& mode,
-      const ContentionMatrix<modes_count>& contention_matrix) {
-    // Check for contention with all the requests in the group which are not in
-    // a denied state.
-    auto it = _requests.Begin();
-    while (it != _requests.End()) {
-      if (contention_matrix[int(it->value.GetMode())][int(mode)] &&
-          !it->value.IsDenied()) {
-        // Contention found with a request so return false.
-        return false;
-      }
-      ++it;
+      const ContentionTable<modes_count>& contention_table) {
+    // Check for contention with the lock modes of all the requests in the group
+    // which are not in a denied state.
+    if (Contends(mode, contention_table)) {
+      // Contention found with a request so return false.
+      return false;
     }
     // No contention found so emplace the request into the group
     auto result = _requests.EmplaceBack(transaction_id, mode);
+    if (result.second) {
+      IncrementModeCount(mode);
+    }
 
     return result.second;
   }
 
+  /**
+   * Check if a request in the given lock mode would contend with the group,
+   * i.e. if it contends with the lock modes of the requests in the group not in
+   * a denied state or if a conversion is pending.
+   *
+   * @param mode Constant reference to the lock mode.
+   * @param contention_table Constant reference to the contention table.
+   * @returns `true` if there is contention else `false`.
+   */
+  bool Contends(const LockMode& mode,
+                const ContentionTable<modes_count>& contention_table) const {
+    return _conversions_count > 0 || contention_table.Contends(_modes, mode);
+  }
+
   /**
    * Get the lock request in the group for the given transaction identifier. If
    * no such request exists then a `std::out_of_range` exception is thrown.
@@ -98,6 +119,25 @@ class LockRequestGroup {
     return _requests.At(transaction_id);
   }
 
+  /**
+   * Deny the lock request for the given transaction identifier in the group.
+   * The denied request no longer contends with new requests. If no request
+   * exists for the transaction identifier then a `std::out_of_range` exception
+   * is thrown.
+   *
+   * @note Requests should be denied through this method, rather than through
+   * the request itself, so that the lock mode counts are kept up to date.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void DenyLockRequest(const TransactionId& transaction_id) {
+    auto& request = _requests.At(transaction_id);
+    if (!request.IsDenied()) {
+      request.Deny();
+      DecrementModeCount(request.GetMode());
+    }
+  }
+
   /**
    * Remove lock request for the given transaction identifier from the group. If
    * no request exists for the transaction identifier then a `std::out_of_range`
@@ -106,9 +146,84 @@ class LockRequestGroup {
    * @param transaction_id Constant reference to the transaction identifier.
    */
   void RemoveLockRequest(const TransactionId& transaction_id) {
+    auto& request = _requests.At(transaction_id);
+    if (!request.IsDenied()) {
+      DecrementModeCount(request.GetMode());
+    }
+    if (request.IsConverting()) {
+      --_conversions_count;
+    }
     _requests.Erase(transaction_id);
   }
 
+  /**
+   * Convert the lock request for the given transaction identifier in the group
+   * to the given lock mode if the mode does not contend with the lock modes of
+   * the other requests in the group not in a denied state. The pending
+   * conversion of the request, if any, ends on success. If no request exists
+   * for the transaction identifier then a `std::out_of_range` exception is
+   * thrown.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode to convert to.
+   * @param contention_table Constant reference to the contention table.
+   * @returns `true` on success else `false`.
+   */
+  bool ConvertLockRequest(
+      const TransactionId& transaction_id, const LockMode& mode,
+      const ContentionTable<modes_count>& contention_table) {
+    auto& request = _requests.At(transaction_id);
+    // The request does not contend with itself
+    DecrementModeCount(request.GetMode());
+    if (contention_table.Contends(_modes, mode)) {
+      IncrementModeCount(request.GetMode());
+      return false;
+    }
+    IncrementModeCount(mode);
+    request.SetMode(mode);
+    EndConversion(transaction_id);
+    return true;
+  }
+
+  /**
+   * Start the conversion of the lock request for the given transaction
+   * identifier in the group to the given lock mode. If no request exists for
+   * the transaction identifier then a `std::out_of_range` exception is thrown.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode to convert to.
+   */
+  void BeginConversion(const TransactionId& transaction_id,
+                       const LockMode& mode) {
+    auto& request = _requests.At(transaction_id);
+    if (!request.IsConverting()) {
+      ++_conversions_count;
+    }
+    request.BeginConversion(mode);
+  }
+
+  /**
+   * End the pending conversion of the lock request for the given transaction
+   * identifier in the group, if any. If no request exists for the transaction
+   * identifier then a `std::out_of_range` exception is thrown.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void EndConversion(const TransactionId& transaction_id) {
+    auto& request = _requests.At(transaction_id);
+    if (request.IsConverting()) {
+      request.EndConversion();
+      --_conversions_count;
+    }
+  }
+
+  /**
+   * Check if the conversion of any request in the group is pending.
+   *
+   * @returns `true` if a conversion is pending else `false`.
+   */
+  bool HasConversions() const { return _conversions_count > 0; }
+
   /**
    * Get the number of requests in the group.
    *
@@ -152,8 +267,36 @@ class LockRequestGroup {
   ConstIterator End() const { return _requests.End(); }
 
  private:
+  /**
+   * Increment the count of requests in the given lock mode.
+   *
+   * @param mode Constant reference to the lock mode.
+   */
+  void IncrementModeCount(const LockMode& mode) {
+    if (_mode_counts[size_t(mode)]++ == 0) {
+      _modes |= ContentionTable<modes_count>::Mask(mode);
+    }
+  }
+
+  /**
+   * Decrement the count of requests in the given lock mode.
+   *
+   * @param mode Constant reference to the lock mode.
+   */
+  void DecrementModeCount(const LockMode& mode) {
+    if (--_mode_counts[size_t(mode)] == 0) {
+      _modes &= ~ContentionTable<modes_count>::Mask(mode);
+    }
+  }
+
   // Indexed list of lock requests which are part of the group.
   LockRequestList _requests;
+  // Number of requests not in a denied state for each lock mode.
+  std::array<size_t, modes_count> _mode_counts;
+  // Bitmask of the lock modes having requests not in a denied state.
+  LockModeMask _modes;
+  // Number of requests with a pending conversion.
+  size_t _conversions_count;
 };
 
 }  // namespace details
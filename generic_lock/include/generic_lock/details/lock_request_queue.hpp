@@ -70,18 +70,18 @@ class LockRequestQueue {
    *
    * @param transaction_id Constant reference to the transaction identifier.
    * @param mode Constant reference to the requested lock mode.
-   * @param contention_matrix Constant reference to the contention matrix.
+   * @param contention_table Constant reference to the contention table.
    * @returns Constant reference to the identifier of the group to which the
    * emplaced request belongs.
    */
   const LockRequestGroupId& EmplaceLockRequest(
       const TransactionId& transaction_id, const LockMode& mode,
-      const ContentionMatrix<modes_count>& contention_matrix) {
+      const ContentionTable<modes_count>& contention_table) {
     // If no group exist in the queue then create a new group and emplace
     // the request in it
     if (groups_.Empty()) {
       return EmplaceNewRequestGroup(null_group_id + 1, transaction_id, mode,
-                                    contention_matrix);
+                                    contention_table);
     }
 
     // Check that a prior request by the same transaction does not exist
@@ -95,7 +95,7 @@ class LockRequestQueue {
     // group
     auto& last_group = groups_.Back();
     if (last_group.value.EmplaceLockRequest(transaction_id, mode,
-                                            contention_matrix)) {
+                                            contention_table)) {
       group_id_map_[transaction_id] = last_group.key;
       return last_group.key;
     }
@@ -103,7 +103,7 @@ class LockRequestQueue {
     // Could not emplace into the last group so create a new group and emplace
     // the request inside it
     return EmplaceNewRequestGroup(last_group.key + 1, transaction_id, mode,
-                                  contention_matrix);
+                                  contention_table);
   }
 
   /**
@@ -131,6 +131,17 @@ class LockRequestQueue {
     return groups_.At(group_id).GetLockRequest(transaction_id);
   }
 
+  /**
+   * Deny the request for the given transaction identifier in the queue. A
+   * `std::out_of_range` exception is thrown if no request exists.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void DenyLockRequest(const TransactionId& transaction_id) {
+    auto& group_id = group_id_map_.at(transaction_id);
+    groups_.At(group_id).DenyLockRequest(transaction_id);
+  }
+
   /**
    * Remove a request for the given transaction identifier from the queue. A
    * `std::out_of_range` exception is thrown if no request exists.
@@ -147,6 +158,36 @@ class LockRequestQueue {
     group_id_map_.erase(transaction_id);
   }
 
+  /**
+   * Move the request for the given transaction identifier into the front group
+   * of the queue if it does not contend with the group. The group left empty by
+   * the move, if any, is removed. A `std::out_of_range` exception is thrown if
+   * no request exists.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param contention_table Constant reference to the contention table.
+   * @returns `true` if the request is moved else `false`.
+   */
+  bool PromoteLockRequest(
+      const TransactionId& transaction_id,
+      const ContentionTable<modes_count>& contention_table) {
+    auto& group_id = group_id_map_.at(transaction_id);
+    auto& group = groups_.At(group_id);
+    auto& front_group = *groups_.Begin();
+    if (front_group.key == group_id ||
+        !front_group.value.EmplaceLockRequest(
+            transaction_id, group.GetLockRequest(transaction_id).GetMode(),
+            contention_table)) {
+      return false;
+    }
+    group.RemoveLockRequest(transaction_id);
+    if (group.Empty()) {
+      groups_.Erase(group_id);
+    }
+    group_id = front_group.key;
+    return true;
+  }
+
   /**
    * Check if a lock request for the given transaction identifier exists in the
    * queue.
@@ -154,7 +195,7 @@ class LockRequestQueue {
    * @param transaction_id Constant reference to the transaction identifier.
    * @returns `true` if request is in the queue else `false`.
    */
-  bool LockRequestExists(const TransactionId& transaction_id) {
+  bool LockRequestExists(const TransactionId& transaction_id) const {
     return group_id_map_.find(transaction_id) != group_id_map_.end();
   }
 
@@ -169,6 +210,28 @@ class LockRequestQueue {
     return group_id_map_.at(transaction_id);
   }
 
+  /**
+   * Find the lock request group with the given identifier.
+   *
+   * @param group_id Constant reference to the lock request group identifier.
+   * @returns Iterator pointing to the group, or to the end of the queue if no
+   * such group exists.
+   */
+  Iterator FindGroup(const LockRequestGroupId& group_id) {
+    return groups_.Find(group_id);
+  }
+
+  /**
+   * Find the lock request group with the given identifier.
+   *
+   * @param group_id Constant reference to the lock request group identifier.
+   * @returns Constant iterator pointing to the group, or to the end of the
+   * queue if no such group exists.
+   */
+  ConstIterator FindGroup(const LockRequestGroupId& group_id) const {
+    return groups_.Find(group_id);
+  }
+
   /**
    * Get an iterator pointing to the begining of the container.
    *
@@ -219,20 +282,20 @@ class LockRequestQueue {
    * @param group_id Constant reference to the new group identifier.
    * @param transaction_id Constant reference to the transaction identifier.
    * @param mode Constant reference to the lock mode.
-   * @param contention_matrix Constant reference to the contention matrix.
+   * @param contention_table Constant reference to the contention table.
    * @returns Constant reference to the newly created group identifier.
    */
   const LockRequestGroupId& EmplaceNewRequestGroup(
       const LockRequestGroupId& group_id, const TransactionId& transaction_id,
       const LockMode& mode,
-      const ContentionMatrix<modes_count>& contention_matrix) {
+      const ContentionTable<modes_count>& contention_table) {
     // Creates an empty request group
     auto result = groups_.EmplaceBack(group_id);
     // Assert that we were able to create the empty group.
     assert(result.second);
     // Emplace the request into the group
     result.first->value.EmplaceLockRequest(transaction_id, mode,
-                                           contention_matrix);
+                                           contention_table);
     // Record the mapping between the transaction and the new group identifier
     group_id_map_[transaction_id] = result.first->key;
     // Return the new group identifier
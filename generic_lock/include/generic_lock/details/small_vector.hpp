@@ -0,0 +1,255 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__DETAILS__SMALL_VECTOR_HPP
+#define GENERIC_LOCK__DETAILS__SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace gl {
+namespace details {
+
+/**
+ * A small vector is a container storing up to `inline_capacity` values inline,
+ * i.e. without any heap allocation. The values are moved to a heap allocated
+ * buffer only once the container grows past its inline capacity. The order of
+ * the values is not preserved on erase, which is thus an O(1) operation.
+ *
+ * @tparam ValueType The type of value. It should be nothrow move
+ * constructible.
+ * @tparam inline_capacity The number of values stored inline.
+ */
+template <class ValueType, size_t inline_capacity>
+class SmallVector {
+  static_assert(inline_capacity > 0, "Inline capacity should be non-zero.");
+
+ public:
+  typedef ValueType* Iterator;
+  typedef const ValueType* ConstIterator;
+
+  /**
+   * Construct a new Small Vector object.
+   *
+   */
+  SmallVector()
+      : _data(InlineData()), _size(0), _capacity(inline_capacity) {}
+
+  // Small vector not copyable
+  SmallVector(const SmallVector& other) = delete;
+
+  /**
+   * Move construct a new Small Vector object.
+   *
+   * @param other Rvalue reference to the other small vector.
+   */
+  SmallVector(SmallVector&& other) noexcept
+      : _data(InlineData()), _size(0), _capacity(inline_capacity) {
+    *this = std::move(other);
+  }
+
+  /**
+   * Destroy the Small Vector object.
+   *
+   */
+  ~SmallVector() {
+    Clear();
+    Deallocate();
+  }
+
+  // Small vector not copy assignable
+  SmallVector& operator=(const SmallVector& other) = delete;
+
+  /**
+   * Move assign the small vector.
+   *
+   * @param other Rvalue reference to the other small vector.
+   * @returns Reference to the small vector.
+   */
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    Clear();
+    Deallocate();
+    if (other.IsInline()) {
+      std::uninitialized_move(other.Begin(), other.End(), _data);
+      _size = other._size;
+      other.Clear();
+    } else {
+      _data = other._data;
+      _size = other._size;
+      _capacity = other._capacity;
+      other._data = other.InlineData();
+      other._size = 0;
+      other._capacity = inline_capacity;
+    }
+    return *this;
+  }
+
+  /**
+   * Append a value at the end of the container.
+   *
+   * @param value Constant reference to the value.
+   */
+  void PushBack(const ValueType& value) {
+    if (_size == _capacity) {
+      Grow();
+    }
+    new (_data + _size) ValueType(value);
+    ++_size;
+  }
+
+  /**
+   * Erase the value at the given position by replacing it with the last value
+   * in the container.
+   *
+   * @param pos Iterator pointing to the value to erase.
+   */
+  void Erase(Iterator pos) {
+    auto last = _data + --_size;
+    if (pos != last) {
+      *pos = std::move(*last);
+    }
+    last->~ValueType();
+  }
+
+  /**
+   * Remove all the values from the container. The allocated buffer, if any, is
+   * retained.
+   *
+   */
+  void Clear() {
+    std::destroy(_data, _data + _size);
+    _size = 0;
+  }
+
+  /**
+   * Get the value at the given position.
+   *
+   * @param pos The position of the value.
+   * @returns Reference to the value.
+   */
+  ValueType& operator[](size_t pos) { return _data[pos]; }
+
+  /**
+   * Get the value at the given position.
+   *
+   * @param pos The position of the value.
+   * @returns Constant reference to the value.
+   */
+  const ValueType& operator[](size_t pos) const { return _data[pos]; }
+
+  /**
+   * Get an iterator pointing to the begining of the container.
+   *
+   * @returns Iterator pointing to the begining of the container.
+   */
+  Iterator Begin() { return _data; }
+
+  /**
+   * Get a constant iterator pointing to the begining of the container.
+   *
+   * @return Constant iterator pointing to the begining of the container.
+   */
+  ConstIterator Begin() const { return _data; }
+
+  /**
+   * Get an iterator pointing to the end of the container.
+   *
+   * @returns Iterator pointing to the end of the container.
+   */
+  Iterator End() { return _data + _size; }
+
+  /**
+   * Get a constant iterator pointing to the end of the container.
+   *
+   * @returns Constant iterator pointing to the end of the container.
+   */
+  ConstIterator End() const { return _data + _size; }
+
+  /**
+   * Get the number of values in the container.
+   *
+   * @returns Number of values in the container.
+   */
+  size_t Size() const { return _size; }
+
+  /**
+   * Check if the container is empty.
+   *
+   * @returns `true` if empty else `false`.
+   */
+  bool Empty() const { return _size == 0; }
+
+  /**
+   * Check if the values are stored inline.
+   *
+   * @returns `true` if stored inline else `false`.
+   */
+  bool IsInline() const { return static_cast<void*>(_data) == _inline; }
+
+ private:
+  /**
+   * Get pointer to the inline storage of the values.
+   *
+   * @returns Pointer to the inline storage.
+   */
+  ValueType* InlineData() { return reinterpret_cast<ValueType*>(_inline); }
+
+  /**
+   * Release the heap allocated buffer, if any, and switch back to the inline
+   * storage. The container should be empty.
+   *
+   */
+  void Deallocate() {
+    if (!IsInline()) {
+      std::allocator<ValueType>().deallocate(_data, _capacity);
+      _data = InlineData();
+      _capacity = inline_capacity;
+    }
+  }
+
+  /**
+   * Double the capacity of the container by moving the values to a larger heap
+   * allocated buffer.
+   *
+   */
+  void Grow() {
+    // The capacity never drops below the inline capacity. Stating it lets the
+    // compiler prove that the new buffer is never empty.
+    auto capacity = 2 * std::max(_capacity, inline_capacity);
+    auto data = std::allocator<ValueType>().allocate(capacity);
+    for (size_t i = 0; i < _size; ++i) {
+      new (data + i) ValueType(std::move(_data[i]));
+      _data[i].~ValueType();
+    }
+    Deallocate();
+    _data = data;
+    _capacity = capacity;
+  }
+
+  ValueType* _data;
+  size_t _size;
+  size_t _capacity;
+  alignas(ValueType) unsigned char
+      _inline[inline_capacity * sizeof(ValueType)];
+};
+
+}  // namespace details
+}  // namespace gl
+
+#endif /* GENERIC_LOCK__DETAILS__SMALL_VECTOR_HPP */
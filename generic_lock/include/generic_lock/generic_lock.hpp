@@ -15,6 +15,8 @@
 #ifndef GENERIC_LOCK__GENERIC_LOCK_HPP
 #define GENERIC_LOCK__GENERIC_LOCK_HPP
 
+#include <generic_lock/lock_status.hpp>
+#include <chrono>
 #include <system_error>
 
 namespace gl {
@@ -41,6 +43,20 @@ struct AdoptLockTag {
 };
 constexpr AdoptLockTag AdoptLock = AdoptLockTag();
 
+/**
+ * @brief Try to lock tag used for specifing constructor behaviour of generic
+ * lock. If the try to lock tag is passed, the generic lock will try to lock its
+ * underlying mutex during construction without blocking.
+ *
+ */
+struct TryToLockTag {
+  explicit TryToLockTag() = default;
+};
+constexpr TryToLockTag TryToLock = TryToLockTag();
+
+template <class GenericMutex, class Executor>
+class GenericLockAwaitable;
+
 /**
  * @brief Generic lock is a general-purpose generic mutex ownership wrapper. The
  * lock has three possible states:
@@ -111,6 +127,26 @@ class GenericLock {
         owns_(false),
         denied_(false) {}
 
+  /**
+   * @brief Construct a new Generic Lock object and try to acquire a lock on the
+   * mutex without blocking. The lock is not considered denied if it could not
+   * be acquired.
+   *
+   * @param generic_mutex Reference to the generic mutex to manager.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   */
+  GenericLock(GenericMutex& generic_mutex, const record_id_t& record_id,
+              const transaction_id_t& transaction_id, const lock_mode_t& mode,
+              TryToLockTag)
+      : record_id_(record_id),
+        transaction_id_(transaction_id),
+        mode_(mode),
+        generic_mutex_ptr_(&generic_mutex),
+        owns_(generic_mutex_ptr_->TryLock(record_id_, transaction_id_, mode_)),
+        denied_(false) {}
+
   /**
    * @brief Construct a new Generic Lock object assuming the caller already
    * acquired a lock on the mutex.
@@ -180,6 +216,76 @@ class GenericLock {
     return owns_;
   }
 
+  /**
+   * @brief Try to lock the underlying generic mutex without blocking. The lock
+   * is not considered denied if it could not be acquired.
+   *
+   * @returns `true` if the lock is acquired else `false`.
+   */
+  bool TryLock() {
+    if (generic_mutex_ptr_ == nullptr) {
+      throw std::system_error(EPERM, std::system_category(),
+                              "GenericLock::TryLock: references null mutex");
+    }
+    if (owns_) {
+      throw std::system_error(EDEADLK, std::system_category(),
+                              "GenericLock::TryLock: already locked");
+    }
+    owns_ = generic_mutex_ptr_->TryLock(record_id_, transaction_id_, mode_);
+    denied_ = false;
+    return owns_;
+  }
+
+  /**
+   * @brief Lock the underlying generic mutex, blocking for at most the given
+   * duration. The lock is not considered denied if the duration expired before
+   * it could be acquired.
+   *
+   * @tparam Rep An arithmetic type representing the number of ticks.
+   * @tparam Period A ratio representing tick period.
+   * @param duration Constant reference to the maximum time to wait.
+   * @returns Status of the lock request.
+   */
+  template <class Rep, class Period>
+  LockStatus TryLockFor(const std::chrono::duration<Rep, Period>& duration) {
+    if (generic_mutex_ptr_ == nullptr) {
+      throw std::system_error(EPERM, std::system_category(),
+                              "GenericLock::TryLockFor: references null mutex");
+    }
+    if (owns_) {
+      throw std::system_error(EDEADLK, std::system_category(),
+                              "GenericLock::TryLockFor: already locked");
+    }
+    return SetStatus(generic_mutex_ptr_->TryLockFor(record_id_, transaction_id_,
+                                                    mode_, duration));
+  }
+
+  /**
+   * @brief Lock the underlying generic mutex, blocking at most till the given
+   * deadline. The lock is not considered denied if the deadline is reached
+   * before it could be acquired.
+   *
+   * @tparam Clock The clock type of the deadline.
+   * @tparam Duration The duration type of the deadline.
+   * @param deadline Constant reference to the time when to stop waiting.
+   * @returns Status of the lock request.
+   */
+  template <class Clock, class Duration>
+  LockStatus TryLockUntil(
+      const std::chrono::time_point<Clock, Duration>& deadline) {
+    if (generic_mutex_ptr_ == nullptr) {
+      throw std::system_error(
+          EPERM, std::system_category(),
+          "GenericLock::TryLockUntil: references null mutex");
+    }
+    if (owns_) {
+      throw std::system_error(EDEADLK, std::system_category(),
+                              "GenericLock::TryLockUntil: already locked");
+    }
+    return SetStatus(generic_mutex_ptr_->TryLockUntil(
+        record_id_, transaction_id_, mode_, deadline));
+  }
+
   /**
    * @brief Unlock the underlying generic mutex.
    *
@@ -194,6 +300,50 @@ class GenericLock {
     generic_mutex_ptr_->Unlock(record_id_, transaction_id_);
   }
 
+  /**
+   * @brief Convert the lock on the underlying generic mutex into a lock
+   * covering both the held and the given lock mode. The lock mode is updated
+   * to the converted mode on success. The lock is retained if the conversion is
+   * denied, unless it was released meanwhile, e.g. by unlocking all the locks
+   * of the transaction, in which case the mutex is no longer owned.
+   *
+   * @param mode Constant reference to the lock mode to convert to.
+   * @returns `true` if the lock is converted else `false`.
+   */
+  bool Convert(const lock_mode_t& mode) {
+    if (!owns_) {
+      throw std::system_error(EPERM, std::system_category(),
+                              "GenericLock::Convert: not locked");
+    }
+    auto converted_mode =
+        generic_mutex_ptr_->Convert(record_id_, transaction_id_, mode);
+    if (!converted_mode) {
+      owns_ = generic_mutex_ptr_->HoldsLock(record_id_, transaction_id_);
+      return false;
+    }
+    mode_ = *converted_mode;
+    return true;
+  }
+
+  /**
+   * @brief Downgrade the lock on the underlying generic mutex to the given
+   * weaker lock mode. The lock mode is updated on success.
+   *
+   * @param mode Constant reference to the weaker lock mode.
+   * @returns `true` if the lock is downgraded else `false`.
+   */
+  bool Downgrade(const lock_mode_t& mode) {
+    if (!owns_) {
+      throw std::system_error(EPERM, std::system_category(),
+                              "GenericLock::Downgrade: not locked");
+    }
+    if (!generic_mutex_ptr_->Downgrade(record_id_, transaction_id_, mode)) {
+      return false;
+    }
+    mode_ = mode;
+    return true;
+  }
+
   /**
    * @brief Releases ownership of the associated generic mutex without
    * unlocking. If a lock is held prior to this call, the caller is now
@@ -287,6 +437,43 @@ class GenericLock {
   }
 
  private:
+  template <class, class>
+  friend class GenericLockAwaitable;
+
+  /**
+   * @brief Construct a new Generic Lock object with the outcome of a lock
+   * request already made by the caller. The lock owns the mutex if the request
+   * is granted and is denied otherwise.
+   *
+   * @param generic_mutex Reference to the generic mutex to manager.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param granted Flag indicating if the lock request is granted.
+   */
+  GenericLock(GenericMutex& generic_mutex, const record_id_t& record_id,
+              const transaction_id_t& transaction_id, const lock_mode_t& mode,
+              bool granted)
+      : record_id_(record_id),
+        transaction_id_(transaction_id),
+        mode_(mode),
+        generic_mutex_ptr_(&generic_mutex),
+        owns_(granted),
+        denied_(!granted) {}
+
+  /**
+   * @brief Update the ownership of the lock with the status of a timed lock
+   * request.
+   *
+   * @param status Status of the lock request.
+   * @returns The given status.
+   */
+  LockStatus SetStatus(LockStatus status) {
+    owns_ = status == LockStatus::GRANTED;
+    denied_ = status == LockStatus::DENIED;
+    return status;
+  }
+
   record_id_t record_id_;
   transaction_id_t transaction_id_;
   lock_mode_t mode_;
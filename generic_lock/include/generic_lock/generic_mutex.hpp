@@ -18,10 +18,30 @@
 #include <generic_lock/details/condition_variable.hpp>
 #include <generic_lock/details/contention_matrix.hpp>
 #include <generic_lock/details/dependency_graph.hpp>
+#include <generic_lock/details/lock_holder_set.hpp>
 #include <generic_lock/details/lock_request_queue.hpp>
+#include <generic_lock/contention_policy.hpp>
+#include <generic_lock/deadlock_policy.hpp>
+#include <generic_lock/index_policy.hpp>
+#include <generic_lock/lock_status.hpp>
 #include <generic_lock/selection_policy.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <iterator>
 #include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
 
 // TODO: C++11 complient implementation
 
@@ -64,7 +84,48 @@ using ContentionMatrix = details::ContentionMatrix<modes_count>;
  * transaction will be unblocked for recovery, and its lock request denied. The
  * type of policy can be specified through the `SelectionPolicy` template
  * parameter. By default the transaction with the maximum identifier is
- * selected.
+ * selected. The instant at which deadlocks are detected is dictated by the
+ * deadlock policy, specified through the `DeadlockPolicy` template parameter.
+ * By default a waiting transaction checks for deadlock each time its wait
+ * times out. Alternatively, the deadlock policy can prevent deadlocks from
+ * forming using the no-wait, wait-die or wound-wait schemes, in which case no
+ * dependency graph is maintained.
+ *
+ * The lock table can be partitioned into multiple shards through the
+ * `shards_count` template parameter. Each record is mapped to a shard using the
+ * hash of its identifier, and each shard is protected by its own latch. Thus
+ * transactions operating on records belonging to different shards never
+ * contend with each other. The dependency graph used for deadlock detection is
+ * shared across all the shards so that deadlocks spanning records of
+ * different shards are still discovered.
+ *
+ * Most lock requests are on records no other transaction is waiting for. Such
+ * uncontended records keep the transactions holding their lock in a small
+ * inline set, whose capacity is given by the `uncontended_holders_count`
+ * template parameter, and the full request queue of a record is only built
+ * once a request on it has to wait or the set is full. This spares the queue
+ * allocations on uncontended records, but not the shard latch nor the lock
+ * table lookup: there is no atomic state word that an uncontended lock could
+ * be acquired on with a single compare-and-swap.
+ *
+ * Locks are reentrant. A transaction requesting a lock on a record it already
+ * holds in a mode covering the requested mode is granted right away, and the
+ * lock is released once it is unlocked as many times as it was acquired.
+ *
+ * Lock requests can also be made asynchronously, in which case no thread is
+ * blocked while the request waits. Instead a callback is invoked, or a future
+ * fulfilled, once the request is granted or denied. The completion is
+ * delivered by the thread granting or denying the request, such as a
+ * transaction unlocking the record or recovering from a deadlock, after it has
+ * released the internal latches of the mutex.
+ *
+ * A transaction can also lock records through a handle obtained from
+ * `BeginTransaction`, which remembers the shard and lock table entry of each
+ * record it holds a lock on. Locking such a record again and unlocking it then
+ * skip the shard and lock table lookups, and no transaction index is kept for
+ * the handle. The structures keyed on transaction identifiers, such as the
+ * request queues, waiters and dependency graph, are still looked up by
+ * identifier.
  *
  * @note The record and transaction identifiers, along with the lock mode should
  * be hashable types.
@@ -76,30 +137,104 @@ using ContentionMatrix = details::ContentionMatrix<modes_count>;
  * @tparam LockMode The lock mode type.
  * @tparam modes_count The number of lock modes.
  * @tparam timeout The time in milliseconds to wait before checking for
- * deadlock. Default set to `300`.
+ * deadlock. Default set to `300`. When the `DetectInBackgroundPolicy` is used,
+ * this is the interval between deadlock detection rounds. When the
+ * `DetectOnWaitPolicy` is used, this is the interval at which waiting
+ * transactions check for the deadlocks left unresolved on wait.
  * @tparam SelectionPolicy Deadlock recovery selection policy type. Default set
  * to `SelectMaxPolicy<TransactionId>`.
+ * @tparam shards_count The number of partitions of the lock table. Default set
+ * to `1`.
+ * @tparam DeadlockPolicy Deadlock detection or prevention policy type. Default
+ * set to `DetectOnTimeoutPolicy`.
+ * @tparam ContentionPolicy Contention policy type dictating if the contention
+ * matrix is given at runtime or compile time. Default set to
+ * `RuntimeContentionPolicy`.
+ * @tparam IndexPolicy Index policy type dictating if the records locked by
+ * each transaction are indexed for `UnlockAll`. Default set to
+ * `TransactionIndexPolicy`.
+ * @tparam uncontended_holders_count The maximum number of transactions
+ * holding a lock on an uncontended record before its lock request queue is
+ * used. Default set to `4`.
  */
 template <class RecordId, class TransactionId, class LockMode,
           size_t modes_count, size_t timeout = 300,
-          class SelectionPolicy = SelectMaxPolicy<TransactionId>>
+          class SelectionPolicy = SelectMaxPolicy<TransactionId>,
+          size_t shards_count = 1,
+          class DeadlockPolicy = DetectOnTimeoutPolicy,
+          class ContentionPolicy = RuntimeContentionPolicy,
+          class IndexPolicy = TransactionIndexPolicy,
+          size_t uncontended_holders_count = 4>
 class GenericMutex {
+  static_assert(shards_count > 0, "At least one lock table shard is required.");
+  static_assert(uncontended_holders_count > 0,
+                "At least one uncontended holder is required.");
+
+  // Flag indicating if the contention matrix is given at runtime.
+  static constexpr bool runtime_contention =
+      std::is_same_v<ContentionPolicy, RuntimeContentionPolicy>;
+
+  // Flag indicating if the records locked by each transaction are indexed.
+  static constexpr bool indexes_transactions =
+      std::is_same_v<IndexPolicy, TransactionIndexPolicy>;
+
+  // Lock holder set type used for uncontended records
+  typedef details::LockHolderSet<TransactionId, LockMode, modes_count,
+                                 uncontended_holders_count>
+      LockHolderSet;
   // Lock request queue type
   typedef details::LockRequestQueue<TransactionId, LockMode, modes_count>
       LockRequestQueue;
   // Lock request group identifier type
   typedef typename LockRequestQueue::LockRequestGroupId LockRequestGroupId;
+  // Request group of a record. Each group is a node in the dependency graph
+  // depending on the requests in the group and on the group before it.
+  typedef std::pair<RecordId, LockRequestGroupId> RecordGroup;
+  // Node of the dependency graph, either a transaction or a request group.
+  typedef std::variant<TransactionId, RecordGroup> DependencyNode;
+  // Hash function object for the nodes of the dependency graph.
+  struct DependencyNodeHash {
+    size_t operator()(const DependencyNode& node) const {
+      if (auto transaction_id = std::get_if<TransactionId>(&node)) {
+        return std::hash<TransactionId>()(*transaction_id);
+      }
+      auto& group = std::get<RecordGroup>(node);
+      return std::hash<RecordId>()(group.first) ^
+             (std::hash<LockRequestGroupId>()(group.second) << 1);
+    }
+  };
+  // Dependency graph type
+  typedef details::DependencyGraph<DependencyNode, DependencyNodeHash>
+      DependencyGraph;
+
+  // Callback invoked with the outcome of an asynchronous lock request.
+  typedef std::function<void(bool)> Callback;
+  // Waiting transaction, either blocked on its own condition variable so that
+  // it can be notified individually, or waiting asynchronously for its
+  // callback to be invoked.
+  typedef std::variant<details::ConditionVariable*, Callback> Waiter;
+  // Maping identifier of transactions waiting for their lock request on a
+  // record to the waiter.
+  typedef std::unordered_map<TransactionId, Waiter> WaiterMap;
+  // Callback of a completed asynchronous lock request along with its outcome.
+  typedef std::pair<Callback, bool> Completion;
 
-  // Lock table entry containing queue of lock requests, a condition variable
-  // for synchronizing concurrent access, and the currently granted
-  // request group identifier.
+  // Lock table entry containing the holders of an uncontended record, queue of
+  // lock requests, the condition variables of the waiting transactions, and the
+  // currently granted request group identifier. The record is uncontended as
+  // long as its queue is empty, in which case the transactions holding the lock
+  // are kept in the holder set. The holders are moved to the queue once a
+  // request can not be granted right away, and the record stays contended till
+  // its entry is removed. The entry is removed once it has neither holders,
+  // requests nor waiters.
   struct LockTableEntry {
     // Granted group identifier starts with value of `1` since the first
     // group in the request queue has an identifier of `1`.
-    LockTableEntry() : queue(), cv(), granted_group_id(1) {}
+    LockTableEntry() : holders(), queue(), waiters(), granted_group_id(1) {}
 
+    LockHolderSet holders;
     LockRequestQueue queue;
-    details::ConditionVariable cv;
+    WaiterMap waiters;
     LockRequestGroupId granted_group_id;
   };
 
@@ -107,12 +242,54 @@ class GenericMutex {
   // associated with its own request queue via its unique key.
   typedef std::unordered_map<RecordId, LockTableEntry> LockTable;
 
+  // Maping identifier of transactions to the identifiers of the records on
+  // which they hold or wait for a lock. Only maintained by the
+  // `TransactionIndexPolicy`.
+  typedef std::unordered_map<TransactionId, std::unordered_set<RecordId>>
+      TransactionIndex;
+
+  // Partition of the lock table containing a subset of the records along with
+  // the latch protecting them. Shards are aligned to separate cache lines in
+  // order to avoid false sharing between their latches.
+  struct alignas(64) LockTableShard {
+    // Latch for atomic modification of the shard.
+    std::mutex latch;
+    // Lock table recording state of the records in the shard.
+    LockTable table;
+    // Records of the shard locked by each transaction.
+    TransactionIndex index;
+  };
+
   // Maping identifier of transactions waiting for thier lock request to be
   // granted to the identifier of the record for which the lock is desired.
   typedef std::unordered_map<TransactionId, RecordId> WaitMap;
 
+  // Identifier of a waiting transaction along with the identifier of the record
+  // on which it is waiting.
+  typedef std::pair<TransactionId, RecordId> WaitingTransaction;
+
   // Lock type.
   typedef std::unique_lock<std::mutex> UniqueLock;
+  // Guard type.
+  typedef std::lock_guard<std::mutex> LockGuard;
+  // Deadline of a timed lock request.
+  typedef std::chrono::steady_clock::time_point Deadline;
+
+  // Flag indicating if deadlocks are detected using the dependency graph, as
+  // opposed to being prevented.
+  static constexpr bool detects_deadlocks =
+      std::is_same_v<DeadlockPolicy, DetectOnTimeoutPolicy> ||
+      std::is_same_v<DeadlockPolicy, DetectOnWaitPolicy> ||
+      std::is_same_v<DeadlockPolicy, DetectInBackgroundPolicy>;
+  // Flag indicating if waiting transactions periodically check for deadlocks,
+  // which is a backstop for the deadlocks missed on wait under the
+  // `DetectOnWaitPolicy`.
+  static constexpr bool checks_on_timeout =
+      std::is_same_v<DeadlockPolicy, DetectOnTimeoutPolicy> ||
+      std::is_same_v<DeadlockPolicy, DetectOnWaitPolicy>;
+  // Flag indicating if the waiting transactions are tracked in the wait map.
+  static constexpr bool tracks_waiters =
+      detects_deadlocks || std::is_same_v<DeadlockPolicy, WoundWaitPolicy>;
 
  public:
   // Mutex traits
@@ -125,8 +302,44 @@ class GenericMutex {
    *
    * @param contention_matrix Constant reference to the contention matrix.
    */
+  template <bool _runtime_contention = runtime_contention,
+            std::enable_if_t<_runtime_contention, int> = 0>
   GenericMutex(const ContentionMatrix<modes_count>& contention_matrix)
-      : contention_matrix_(contention_matrix) {}
+      : contention_table_(contention_matrix),
+        conversion_table_(contention_matrix),
+        detector_stopped_(false) {
+    StartDeadlockDetector();
+  }
+
+  /**
+   * @brief Construct a new Generic Mutex object using the contention matrix
+   * given at compile time through the contention policy.
+   *
+   */
+  template <bool _runtime_contention = runtime_contention,
+            std::enable_if_t<!_runtime_contention, int> = 0>
+  GenericMutex()
+      : contention_table_(ContentionPolicy::contention_table),
+        conversion_table_(ContentionPolicy::conversion_table),
+        detector_stopped_(false) {
+    StartDeadlockDetector();
+  }
+
+  /**
+   * @brief Destroy the Generic Mutex object. The background deadlock detector,
+   * if any, is stopped.
+   *
+   */
+  ~GenericMutex() {
+    if constexpr (std::is_same_v<DeadlockPolicy, DetectInBackgroundPolicy>) {
+      {
+        LockGuard guard(detector_latch_);
+        detector_stopped_ = true;
+      }
+      detector_cv_.NotifyOne();
+      detector_.join();
+    }
+  }
 
   // Mutex not copyable
   GenericMutex(const GenericMutex& other) = delete;
@@ -136,7 +349,10 @@ class GenericMutex {
   /**
    * @brief Acquire a lock on a record with the given identifier. The calling
    * transaction is blocked till the lock is successfully acquired or till the
-   * request is denied due to deadlock discovery.
+   * request is denied due to deadlock discovery or prevention. If the
+   * transaction already holds a lock on the record covering the given mode, the
+   * lock is acquired once more without blocking. A request for a mode not
+   * covered by the held lock is denied, the lock should be converted instead.
    *
    * @param record_id Constant reference to the record identifier.
    * @param transaction_id Constant reference to the transaction identifier.
@@ -145,264 +361,2452 @@ class GenericMutex {
    */
   bool Lock(const RecordId& record_id, const TransactionId& transaction_id,
             const LockMode& mode) {
-    UniqueLock lock(latch_);
-
-    // Creates a lock table entry if it does not exist already
-    auto& entry = table_[record_id];
+    return AcquireLock(GetShard(record_id), record_id, transaction_id, mode,
+                       std::nullopt, true) == LockStatus::GRANTED;
+  }
 
-    // Emplace request in the queue of the record identifier
-    auto& group_id = entry.queue.EmplaceLockRequest(transaction_id, mode,
-                                                    contention_matrix_);
-    // If the request could not be emplaced then return
-    if (group_id == LockRequestQueue::null_group_id) {
+  /**
+   * @brief Try to acquire a lock on a record with the given identifier without
+   * blocking. The lock is acquired only if it can be granted right away.
+   * Otherwise nothing is left behind in the request queue or the dependency
+   * graph.
+   *
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @returns `true` if the lock is successfully acquired, otherwise `false`.
+   */
+  bool TryLock(const RecordId& record_id, const TransactionId& transaction_id,
+               const LockMode& mode) {
+    if (ConsumeWound(transaction_id)) {
       return false;
     }
-    // If the emplaced request belong to the granted group then return as the
-    // lock has been granted successfully.
-    if (group_id == entry.granted_group_id) {
-      return true;
+
+    auto& shard = GetShard(record_id);
+    LockGuard guard(shard.latch);
+    return TryAcquireLock(shard, record_id, transaction_id, mode, true, true)
+        .value_or(false);
+  }
+
+  /**
+   * @brief Acquire locks on multiple records with the given identifiers. The
+   * requests are sorted into a canonical order, by the shard of their records,
+   * the hash of their identifiers and then their identifiers, and made strictly
+   * in that order, so that transactions locking overlapping sets of records
+   * never deadlock with each other. The latch of a shard is acquired once for a
+   * run of requests on its records that can be granted right away. The calling
+   * transaction blocks on the first conflicting request of the run, and the
+   * requests after it are only made once it is granted. Once a conflicting
+   * request is denied due to deadlock discovery or prevention, the requests
+   * after it are not made.
+   *
+   * @note The record identifiers should be ordered by `std::less`.
+   *
+   * @param requests Constant reference to the identifiers of the records along
+   * with the lock modes requested on them.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns Flags indicating for each request, in the given order, if the lock
+   * is successfully acquired.
+   */
+  std::vector<bool> LockAll(
+      const std::vector<std::pair<RecordId, LockMode>>& requests,
+      const TransactionId& transaction_id) {
+    std::vector<bool> granted(requests.size(), false);
+    if (ConsumeWound(transaction_id)) {
+      return granted;
     }
 
-    // Either a new group is created or the request is emplaced in the last
-    // group. This implies that the transaction needs to wait till the request
-    // can be granted. Furthermore, the transaction is dependent on the prior
-    // requests to be granted. We thus have to update the dependency graph and
-    // put the transaction into wait mode.
-    InsertDependency(entry.queue, transaction_id);
-    wait_map_[transaction_id] = record_id;
-    entry.cv.Wait(
-        lock, timeout_,
-        std::bind(&GenericMutex::DeadlockCheck, this, record_id,
-                  transaction_id),
-        std::bind(&GenericMutex::StopWaiting, this, record_id, transaction_id));
-    wait_map_.erase(transaction_id);
-
-    // Check if the request was denied. Happens on deadlock discovery.
-    if (entry.queue.GetLockRequest(transaction_id).IsDenied()) {
-      // Permform cleanup by removing all the dependencies existing in the
-      // dependency graph for the transaction. Note that all the
-      // dependent/depended requests of the denied request will exist only in
-      // the current queue. We dont need to check queues associated with the
-      // other record identifiers.
-      RemoveDependency(entry.queue, transaction_id);
-      // Remove the lock request from the queue
-      entry.queue.RemoveLockRequest(transaction_id);
+    auto order = OrderRequests(requests);
+    for (auto it = order.begin(); it != order.end();) {
+      auto& shard = shards_[it->first % shards_count];
+      std::optional<bool> acquired;
+      {
+        LockGuard guard(shard.latch);
+        for (;
+             it != order.end() && &shards_[it->first % shards_count] == &shard;
+             ++it) {
+          auto& request = requests[it->second];
+          acquired = TryAcquireLock(shard, request.first, transaction_id,
+                                    request.second, true, true);
+          if (!acquired) {
+            break;
+          }
+          granted[it->second] = *acquired;
+        }
+      }
+      if (acquired) {
+        continue;
+      }
+
+      // The conflicting request is made blocking before any request after it.
+      auto& request = requests[it->second];
+      granted[it->second] =
+          AcquireLock(shard, request.first, transaction_id, request.second,
+                      std::nullopt, true) == LockStatus::GRANTED;
+      if (!granted[it->second]) {
+        break;
+      }
+      ++it;
+    }
+    return granted;
+  }
 
+  /**
+   * @brief Try to acquire locks on multiple records with the given identifiers
+   * atomically without blocking. Either all the locks are granted right away,
+   * or none of them is acquired and nothing is left behind in the request
+   * queues or the dependency graph. The latches of all the shards containing
+   * the records are held at once, acquired in shard order, so that no other
+   * transaction observes a partial acquisition. A lock which would overflow
+   * the holder set of an uncontended record is not granted right away, so that
+   * a failed attempt leaves the record uncontended.
+   *
+   * @note The record identifiers should be ordered by `std::less`.
+   *
+   * @param requests Constant reference to the identifiers of the records along
+   * with the lock modes requested on them.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if all the locks are acquired, otherwise `false`.
+   */
+  bool TryLockAll(const std::vector<std::pair<RecordId, LockMode>>& requests,
+                  const TransactionId& transaction_id) {
+    if (ConsumeWound(transaction_id)) {
       return false;
     }
 
-    return true;
+    auto order = OrderRequests(requests);
+    std::vector<UniqueLock> locks;
+    for (auto& position : order) {
+      auto& latch = shards_[position.first % shards_count].latch;
+      if (locks.empty() || locks.back().mutex() != &latch) {
+        locks.emplace_back(latch);
+      }
+    }
+
+    size_t acquired = 0;
+    for (; acquired < order.size(); ++acquired) {
+      auto& request = requests[order[acquired].second];
+      if (!TryAcquireLock(shards_[order[acquired].first % shards_count],
+                          request.first, transaction_id, request.second, true,
+                          false)
+               .value_or(false)) {
+        break;
+      }
+    }
+    if (acquired == order.size()) {
+      return true;
+    }
+
+    // Release the acquired locks in reverse order, so that a record requested
+    // multiple times is released as many times.
+    bool granted = false;
+    while (acquired-- > 0) {
+      granted |= ReleaseLock(shards_[order[acquired].first % shards_count],
+                             requests[order[acquired].second].first,
+                             transaction_id, false, true);
+    }
+    locks.clear();
+    if (granted) {
+      RunCompletions();
+    }
+    return false;
   }
 
   /**
-   * @brief Unlock an already acquired lock on a record with the given
-   * identifier.
+   * @brief Acquire a lock on a record with the given identifier, blocking the
+   * calling transaction for at most the given duration. On timeout the request
+   * is removed from the request queue and the dependency graph, as if it was
+   * never made.
    *
+   * @tparam Rep An arithmetic type representing the number of ticks.
+   * @tparam Period A ratio representing tick period.
    * @param record_id Constant reference to the record identifier.
    * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param duration Constant reference to the maximum time to wait. Note that
+   * the duration must be small enough not to overflow when added to
+   * `std::chrono::steady_clock::now()`.
+   * @returns `LockStatus::GRANTED` if the lock is successfully acquired,
+   * `LockStatus::DENIED` if the request is denied due to deadlock discovery or
+   * prevention, and `LockStatus::TIMEOUT` if the duration expired first.
    */
-  void Unlock(const RecordId& record_id, const TransactionId& transaction_id) {
-    UniqueLock lock(latch_);
+  template <class Rep, class Period>
+  LockStatus TryLockFor(const RecordId& record_id,
+                        const TransactionId& transaction_id,
+                        const LockMode& mode,
+                        const std::chrono::duration<Rep, Period>& duration) {
+    return AcquireLock(
+        GetShard(record_id), record_id, transaction_id, mode,
+        Deadline::clock::now() +
+            std::chrono::ceil<typename Deadline::duration>(duration),
+        true);
+  }
 
-    // Check if an entry exists in the lock table for the given record
-    // identifier.
-    auto table_it = table_.find(record_id);
-    if (table_it == table_.end()) {
+  /**
+   * @brief Acquire a lock on a record with the given identifier, blocking the
+   * calling transaction at most till the given deadline. On timeout the
+   * request is removed from the request queue and the dependency graph, as if
+   * it was never made. The deadline is measured against the steady clock once
+   * the request is made, so it is not affected by later adjustments of its own
+   * clock.
+   *
+   * @tparam Clock The clock type of the deadline.
+   * @tparam Duration The duration type of the deadline.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param deadline Constant reference to the time when to stop waiting.
+   * @returns `LockStatus::GRANTED` if the lock is successfully acquired,
+   * `LockStatus::DENIED` if the request is denied due to deadlock discovery or
+   * prevention, and `LockStatus::TIMEOUT` if the deadline is reached first.
+   */
+  template <class Clock, class Duration>
+  LockStatus TryLockUntil(
+      const RecordId& record_id, const TransactionId& transaction_id,
+      const LockMode& mode,
+      const std::chrono::time_point<Clock, Duration>& deadline) {
+    return TryLockFor(record_id, transaction_id, mode,
+                      deadline - Clock::now());
+  }
+
+  /**
+   * @brief Acquire a lock on a record with the given identifier without
+   * blocking the calling thread. The callback is invoked with `true` once the
+   * lock is acquired, or with `false` if the request is denied due to deadlock
+   * discovery or prevention. It is invoked right away if the request is
+   * granted or denied without waiting. Otherwise it is invoked by the thread
+   * granting or denying the request, once the latches of the mutex are
+   * released, so the callback may make requests on the mutex itself.
+   *
+   * Under the `DetectOnTimeoutPolicy` no thread wakes up periodically on behalf
+   * of the request, so deadlocks closed by the request are checked for as soon
+   * as the request starts waiting.
+   *
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param callback Callback invoked with the outcome of the request. The
+   * signature of the callback function should be equivalent to
+   * `void callback(bool granted) noexcept;`. The callback must not throw, as
+   * it may run within the unlock of another transaction.
+   */
+  void LockAsync(const RecordId& record_id, const TransactionId& transaction_id,
+                 const LockMode& mode, Callback callback) {
+    if (ConsumeWound(transaction_id)) {
+      callback(false);
       return;
     }
 
-    auto& entry = table_it->second;
-    // Check if a granted lock request exists in the queue.
-    if (entry.queue.LockRequestExists(transaction_id)) {
-      if (entry.queue.GetGroupId(transaction_id) == entry.granted_group_id) {
-        // Remove all dependencies for the given transaction identifier.
-        RemoveDependency(entry.queue, transaction_id);
-        // Remove the lock request from the queue
-        entry.queue.RemoveLockRequest(transaction_id);
-        // Check if no more lock requests pending
-        if (entry.queue.Empty()) {
-          // We can remove the entry from the lock table since the request queue
-          // is empty.
-          table_.erase(record_id);
-        } else {
-          // The request queue is not empty so we now check if all the granted
-          // locks have been unlocked. If so, we can wakeup all the waiting
-          // threads associated with the request queue.
-          auto& front_group_id = entry.queue.Begin()->key;
-          if (front_group_id != entry.granted_group_id) {
-            entry.granted_group_id = front_group_id;
-
-            // NOTE: Reduces mutex contention for improved performance.
-            lock.unlock();
-
-            // TODO: [OPTIMIZATION] Insted of notifying all waiting threads,
-            // design an approach to notify only the threads associated with the
-            // granted request group. This reduces unnecessary transaction
-            // wakeups which in turn reduces mutex contention.
-
-            entry.cv.NotifyAll();
-          } else {
-            // Some of the granted lock requests are still not unlocked so do
-            // nothing.
-          }
-        }
-      }
+    auto& shard = GetShard(record_id);
+    UniqueLock lock(shard.latch);
+    auto& entry = shard.table[record_id];
+    if (auto granted = MakeLockRequest(shard, entry, record_id, transaction_id,
+                                       mode, true, true)) {
+      lock.unlock();
+      callback(*granted);
+      return;
     }
+
+    Waiter waiter = std::move(callback);
+    if (!EnqueueLockRequest(lock, shard, entry, record_id, transaction_id,
+                            waiter, true)) {
+      lock.unlock();
+      std::get<Callback>(waiter)(false);
+      return;
+    }
+    // The request might have been completed already while recovering from a
+    // deadlock.
+    lock.unlock();
+    RunCompletions();
   }
 
- private:
   /**
-   * @brief Insert dependency for the given transaction identifier requesting
-   * lock for a record associated with the given request queue.
+   * @brief Acquire a lock on a record with the given identifier without
+   * blocking the calling thread. The returned future is fulfilled with `true`
+   * once the lock is acquired, or with `false` if the request is denied due to
+   * deadlock discovery or prevention.
    *
-   * @note This method is idempotent so its safe to make duplicate calls.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @returns Future fulfilled with the outcome of the request.
+   */
+  std::future<bool> LockAsync(const RecordId& record_id,
+                              const TransactionId& transaction_id,
+                              const LockMode& mode) {
+    // The callback has to be copyable, so the promise is shared with it.
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+    LockAsync(record_id, transaction_id, mode,
+              [promise](bool granted) { promise->set_value(granted); });
+    return future;
+  }
+
+  /**
+   * @brief Convert the lock held by a transaction on a record with the given
+   * identifier into a lock covering both the held and the given lock mode,
+   * i.e. their supremum given by the conversion table. The lock is converted
+   * in place if the new lock mode does not contend with the other holders of
+   * the lock. Otherwise the transaction keeps holding its lock while waiting
+   * for the conversion, ahead of any request made after the conversion. A
+   * conversion closing a deadlock is denied right away, as is a conversion
+   * that the deadlock prevention policy would not let wait. The held lock is
+   * retained if the conversion is denied.
    *
-   * @param queue Constant reference to the lock request queue.
+   * @param record_id Constant reference to the record identifier.
    * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode to convert to.
+   * @returns The lock mode held after the conversion, or null if the
+   * conversion is denied or no lock is held on the record.
    */
-  void InsertDependency(const LockRequestQueue& queue,
-                        const TransactionId& transaction_id) {
-    auto group_id = queue.GetGroupId(transaction_id);
-    auto group_it = queue.Begin();
+  std::optional<LockMode> Convert(const RecordId& record_id,
+                                  const TransactionId& transaction_id,
+                                  const LockMode& mode) {
+    if (ConsumeWound(transaction_id)) {
+      return std::nullopt;
+    }
 
-    // Iterate through the queue till just before the given threads request
-    // group. The request of the given transaction is dependent on all requests
-    // in these groups.
-    while (group_it->key != group_id) {
-      for (auto request_it = group_it->value.Begin();
-           request_it != group_it->value.End(); ++request_it) {
-        // NOTE: The `Add` method is idempotent. This implies that duplicate
-        // calls to the method will have the desired null effect.
-        dependency_graph_.Add(transaction_id, request_it->key);
+    auto& shard = GetShard(record_id);
+    UniqueLock lock(shard.latch);
+    auto table_it = shard.table.find(record_id);
+    if (table_it == shard.table.end()) {
+      return std::nullopt;
+    }
+
+    auto& entry = table_it->second;
+    // Holders of uncontended records are converted in place if possible.
+    if (entry.queue.Empty()) {
+      auto holder = entry.holders.FindHolder(transaction_id);
+      if (!holder) {
+        return std::nullopt;
       }
-      ++group_it;
+      auto converted_mode = GetConversionMode(holder->mode, mode);
+      if (!converted_mode || *converted_mode == holder->mode ||
+          entry.holders.ConvertHolder(transaction_id, *converted_mode,
+                                      GetContentionTable())) {
+        return converted_mode;
+      }
+      MoveHoldersToQueue(entry);
     }
 
-    // Iterate through the queue starting right after the given threads request
-    // group till the end of the queue. All the requests in these groups are
-    // dependent on the request of the given transaction.
-    ++group_it;
-    while (group_it != queue.End()) {
-      for (auto request_it = group_it->value.Begin();
-           request_it != group_it->value.End(); ++request_it) {
-        // NOTE: The `Add` method is idempotent. This implies that duplicate
-        // calls to the method will have the desired null effect.
-        dependency_graph_.Add(request_it->key, transaction_id);
+    // Only a granted lock request can be converted. The granted group is always
+    // at the front of the queue.
+    if (!entry.queue.LockRequestExists(transaction_id) ||
+        entry.queue.GetGroupId(transaction_id) != entry.granted_group_id ||
+        entry.queue.GetLockRequest(transaction_id).IsDenied()) {
+      return std::nullopt;
+    }
+    auto& group = entry.queue.Begin()->value;
+    auto& held_mode = group.GetLockRequest(transaction_id).GetMode();
+    auto converted_mode = GetConversionMode(held_mode, mode);
+    if (!converted_mode || *converted_mode == held_mode ||
+        group.ConvertLockRequest(transaction_id, *converted_mode,
+                                 GetContentionTable())) {
+      return converted_mode;
+    }
+
+    // The conversion has to wait for the contending holders to unlock. When
+    // deadlocks are prevented, the conversion is either denied right away or
+    // the contending transactions are wounded.
+    group.BeginConversion(transaction_id, *converted_mode);
+    if constexpr (std::is_same_v<DeadlockPolicy, NoWaitPolicy>) {
+      group.EndConversion(transaction_id);
+      return std::nullopt;
+    } else if constexpr (std::is_same_v<DeadlockPolicy, WaitDiePolicy>) {
+      if (WaitsOnOlderTransaction(entry.queue, transaction_id)) {
+        group.EndConversion(transaction_id);
+        return std::nullopt;
+      }
+    }
+
+    // The waiter is registered before the latch might be released while
+    // wounding, so that the transaction is notified if the conversion is
+    // denied meanwhile and the lock table entry is kept.
+    details::ConditionVariable cv;
+    entry.waiters[transaction_id] = &cv;
+    bool deadlocked = false;
+    if constexpr (std::is_same_v<DeadlockPolicy, WoundWaitPolicy>) {
+      if (!WoundYoungerTransactions(lock, entry, record_id, transaction_id)) {
+        entry.waiters.erase(transaction_id);
+        group.EndConversion(transaction_id);
+        return std::nullopt;
+      }
+    } else if constexpr (detects_deadlocks) {
+      LockGuard graph_guard(graph_latch_);
+      if (InsertConversionDependency(entry.queue, transaction_id)) {
+        // The conversion closes a deadlock, which is resolved by denying it.
+        RemoveConversionDependency(entry.queue, transaction_id);
+        group.EndConversion(transaction_id);
+        entry.waiters.erase(transaction_id);
+        return std::nullopt;
+      }
+      wait_map_[transaction_id] = record_id;
+      if constexpr (std::is_same_v<DeadlockPolicy, DetectOnWaitPolicy>) {
+        deadlocked = dependency_graph_.HasCycle();
+      }
+    }
+    if (deadlocked) {
+      RecoverFromDeadlocks(lock);
+    }
+    auto stop_converting = std::bind(&GenericMutex::StopConverting, this,
+                                     std::cref(shard), record_id,
+                                     transaction_id);
+    RunCompletions(lock);
+    if constexpr (checks_on_timeout) {
+      cv.Wait(lock, timeout_,
+              std::bind(&GenericMutex::DeadlockCheck, this, std::ref(lock),
+                        record_id, transaction_id),
+              stop_converting);
+    } else {
+      cv.Wait(lock, stop_converting);
+    }
+    entry.waiters.erase(transaction_id);
+
+    // The conversion ended either by being granted or by being denied on
+    // deadlock discovery or when the transaction is wounded. The lock itself is
+    // gone if it was released by `UnlockAll`, which denies the conversion
+    // first.
+    bool released = !entry.queue.LockRequestExists(transaction_id);
+    bool denied =
+        released ||
+        entry.queue.GetLockRequest(transaction_id).GetMode() != *converted_mode;
+    if constexpr (tracks_waiters) {
+      LockGuard graph_guard(graph_latch_);
+      wait_map_.erase(transaction_id);
+      if constexpr (detects_deadlocks) {
+        if (!released) {
+          RemoveConversionDependency(entry.queue, transaction_id);
+        }
+      } else if (denied) {
+        // The denied conversion reports the wound of the transaction.
+        EraseWound(transaction_id);
       }
-      ++group_it;
     }
+    if (released && IsUnused(entry)) {
+      shard.table.erase(record_id);
+    }
+    if (denied) {
+      return std::nullopt;
+    }
+    return converted_mode;
   }
 
   /**
-   * @brief Remove dependency for the given transaction identifier having a lock
-   * request for a record associated with the given request queue.
+   * @brief Check if a transaction holds a lock on a record with the given
+   * identifier. A lock being waited for is not held.
    *
-   * @note This method removes dependencies only if they exist. Thus it is safe
-   * to make duplicate calls.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the lock is held else `false`.
+   */
+  bool HoldsLock(const RecordId& record_id,
+                 const TransactionId& transaction_id) {
+    auto& shard = GetShard(record_id);
+    LockGuard guard(shard.latch);
+    auto table_it = shard.table.find(record_id);
+    if (table_it == shard.table.end()) {
+      return false;
+    }
+    auto& entry = table_it->second;
+    if (entry.queue.Empty()) {
+      return entry.holders.FindHolder(transaction_id) != nullptr;
+    }
+    return entry.queue.LockRequestExists(transaction_id) &&
+           entry.queue.GetGroupId(transaction_id) == entry.granted_group_id &&
+           !entry.queue.GetLockRequest(transaction_id).IsDenied();
+  }
+
+  /**
+   * @brief Downgrade the lock held by a transaction on a record with the given
+   * identifier to the given weaker lock mode, i.e. a mode covered by the held
+   * mode. The lock mode is changed in place, and the waiting requests no
+   * longer contending with the granted requests are granted right away.
    *
-   * @param queue Constant reference to the lock request queue.
+   * @param record_id Constant reference to the record identifier.
    * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the weaker lock mode.
+   * @returns `true` if the lock is downgraded, `false` if the lock mode is not
+   * weaker than the held mode or no lock is held on the record.
    */
-  void RemoveDependency(const LockRequestQueue& queue,
-                        const TransactionId& transaction_id) {
-    auto group_id = queue.GetGroupId(transaction_id);
-    auto group_it = queue.Begin();
+  bool Downgrade(const RecordId& record_id, const TransactionId& transaction_id,
+                 const LockMode& mode) {
+    auto& shard = GetShard(record_id);
+    UniqueLock lock(shard.latch);
+    auto table_it = shard.table.find(record_id);
+    if (table_it == shard.table.end()) {
+      return false;
+    }
 
-    // Iterate through the queue till just before the given threads request
-    // group. The request of the given transaction is dependent on all requests
-    // in these groups.
-    while (group_it->key != group_id) {
-      for (auto request_it = group_it->value.Begin();
-           request_it != group_it->value.End(); ++request_it) {
-        // NOTE: The `Remove` method only removes dependency if it exist. Thus
-        // duplicate calls to the method has the desired null effect.
-        dependency_graph_.Remove(transaction_id, request_it->key);
+    auto& entry = table_it->second;
+    // Uncontended records have no waiting requests to grant.
+    if (entry.queue.Empty()) {
+      auto holder = entry.holders.FindHolder(transaction_id);
+      if (!holder || GetConversionMode(holder->mode, mode) != holder->mode) {
+        return false;
       }
-      ++group_it;
+      return entry.holders.ConvertHolder(transaction_id, mode,
+                                         GetContentionTable());
     }
 
-    // Iterate through the queue starting right after the given threads request
-    // group till the end of the queue. All the requests in these groups are
-    // dependnet on the request of the given transaction.
-    ++group_it;
-    while (group_it != queue.End()) {
-      for (auto request_it = group_it->value.Begin();
-           request_it != group_it->value.End(); ++request_it) {
-        // NOTE: The `Remove` method only removes dependency if it exist. Thus
-        // duplicate calls to the method has the desired null effect.
-        dependency_graph_.Remove(request_it->key, transaction_id);
-      }
-      ++group_it;
+    if (!entry.queue.LockRequestExists(transaction_id) ||
+        entry.queue.GetGroupId(transaction_id) != entry.granted_group_id) {
+      return false;
+    }
+    auto& group = entry.queue.Begin()->value;
+    auto& request = group.GetLockRequest(transaction_id);
+    if (request.IsDenied() ||
+        GetConversionMode(request.GetMode(), mode) != request.GetMode() ||
+        !group.ConvertLockRequest(transaction_id, mode,
+                                  GetContentionTable())) {
+      return false;
     }
+    GrantConversions(entry);
+    GrantCompatibleRequests(entry, record_id);
+    lock.unlock();
+    RunCompletions();
+    return true;
   }
 
   /**
-   * @brief Method to check if a transaction should stop waiting. A transaction
-   * can stop waiting if its lock request is granted or if the request is denied
-   * due to a deadlock discovery.
+   * @brief Unlock an already acquired lock on a record with the given
+   * identifier. A lock acquired multiple times by the transaction is released
+   * only once it is unlocked as many times.
    *
    * @param record_id Constant reference to the record identifier.
    * @param transaction_id Constant reference to the transaction identifier.
-   * @returns `true` if transaction can stop wating else `false`.
    */
-  bool StopWaiting(const RecordId& record_id,
-                   const TransactionId& transaction_id) const {
-    auto& entry = table_.at(record_id);
-    // Stop waiting if the request is granted or it is denied due to discovery
-    // of a deadlock.
-    return (entry.queue.GetGroupId(transaction_id) == entry.granted_group_id) ||
-           entry.queue.GetLockRequest(transaction_id).IsDenied();
+  void Unlock(const RecordId& record_id, const TransactionId& transaction_id) {
+    auto& shard = GetShard(record_id);
+    UniqueLock lock(shard.latch);
+    bool granted = ReleaseLock(shard, record_id, transaction_id, false, true);
+    lock.unlock();
+    if (granted) {
+      RunCompletions();
+    }
+    ClearWound(transaction_id);
   }
 
   /**
-   * @brief Check for presence of a deadlock and perform recovery actions if it
-   * exists.
+   * @brief Unlock all the locks held by a transaction, irrespective of the
+   * number of times they were acquired. The waiting requests and pending
+   * conversions of the transaction are denied as well, waking up the threads
+   * of the transaction blocked on them. The latch of each shard is acquired
+   * only once, and the asynchronous requests granted in the process are
+   * completed together at the end. Only the records locked by the transaction
+   * are visited, unless the `NoIndexPolicy` is used, in which case the lock
+   * table of each shard is scanned.
    *
-   * @param record_id Constant reference to the record identifier.
    * @param transaction_id Constant reference to the transaction identifier.
    */
-  void DeadlockCheck(const RecordId& record_id,
-                     const TransactionId& transaction_id) {
-    // Check if the request associated with the given transaction identifier is
-    // denied. In that case there is no need to run the deadlock check and
-    // we can simply return. This avoids unnecessary deadlock checks.
-    if (table_.at(record_id).queue.GetLockRequest(transaction_id).IsDenied()) {
-      return;
+  void UnlockAll(const TransactionId& transaction_id) {
+    for (auto& shard : shards_) {
+      LockGuard guard(shard.latch);
+      if constexpr (indexes_transactions) {
+        auto index_it = shard.index.find(transaction_id);
+        if (index_it == shard.index.end()) {
+          continue;
+        }
+        auto record_ids = std::move(index_it->second);
+        shard.index.erase(index_it);
+        for (auto& record_id : record_ids) {
+          auto table_it = shard.table.find(record_id);
+          if (table_it != shard.table.end()) {
+            ReleaseAllLocks(shard, table_it, transaction_id);
+          }
+        }
+      } else {
+        for (auto table_it = shard.table.begin();
+             table_it != shard.table.end();) {
+          table_it = ReleaseAllLocks(shard, table_it, transaction_id);
+        }
+      }
+    }
+    if constexpr (std::is_same_v<DeadlockPolicy, WoundWaitPolicy>) {
+      // The transaction has aborted, its identifier may be reused.
+      LockGuard graph_guard(graph_latch_);
+      EraseWound(transaction_id);
     }
+    RunCompletions();
+  }
 
-    // Search for presence of deadlock
-    auto cycle = dependency_graph_.DetectCycle(transaction_id);
-    if (!cycle.empty()) {
-      // Instantiates selection policy for deadlock recovery
-      SelectionPolicy policy;
-      // Select transaction identifer to deny request for deadlock recovery
-      auto _thread_id = policy(cycle);
+  /**
+   * @brief Transaction handle locking records of the generic mutex on behalf of
+   * a single transaction. The handle maps each record it holds a lock on to the
+   * shard and lock table entry of the record, which stay in place while the
+   * lock is held. Locking such a record again, and unlocking it, thus skips the
+   * shard and lock table lookups. The lock table entry is only looked up by its
+   * record identifier once the last lock on it is released, in order to remove
+   * it. Locks are reentrant as usual, each acquisition through the handle is
+   * released by a matching call to `Unlock`. All the locks still held are
+   * released once the handle is destroyed.
+   *
+   * @note Locks acquired through the handle are not tracked in the transaction
+   * index. While the handle exists, its transaction should only lock and
+   * unlock records through it. The handle should not outlive the mutex.
+   */
+  class Transaction {
+   public:
+    /**
+     * @brief Construct a new Transaction object taking over the locks held by
+     * the other handle.
+     *
+     * @param other Rvalue reference to the other handle.
+     */
+    Transaction(Transaction&& other) noexcept
+        : generic_mutex_ptr_(std::exchange(other.generic_mutex_ptr_, nullptr)),
+          transaction_id_(std::move(other.transaction_id_)),
+          held_locks_(std::exchange(other.held_locks_, {})) {}
+
+    /**
+     * @brief Release the locks held by the handle and take over the locks held
+     * by the other handle.
+     *
+     * @param other Rvalue reference to the other handle.
+     * @returns Reference to the handle.
+     */
+    Transaction& operator=(Transaction&& other) noexcept {
+      if (this != &other) {
+        End();
+        generic_mutex_ptr_ = std::exchange(other.generic_mutex_ptr_, nullptr);
+        transaction_id_ = std::move(other.transaction_id_);
+        held_locks_ = std::exchange(other.held_locks_, {});
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Destroy the Transaction object. All the locks still held through
+     * the handle are released.
+     *
+     */
+    ~Transaction() { End(); }
+
+    // Handle not copyable
+    Transaction(const Transaction& other) = delete;
+    // Handle not copy assignable
+    Transaction& operator=(const Transaction& other) = delete;
+
+    /**
+     * @brief Get the identifier of the transaction.
+     *
+     * @returns Constant reference to the transaction identifier.
+     */
+    const TransactionId& Id() const { return transaction_id_; }
+
+    /**
+     * @brief Acquire a lock on a record with the given identifier, blocking
+     * just like `GenericMutex::Lock`.
+     *
+     * @param record_id Constant reference to the record identifier.
+     * @param mode Constant reference to the lock mode.
+     * @returns `true` if the lock is successfully acquired, otherwise `false`.
+     */
+    bool Lock(const RecordId& record_id, const LockMode& mode) {
+      if (generic_mutex_ptr_->ConsumeWound(transaction_id_)) {
+        return false;
+      }
+
+      auto [held_it, inserted] = held_locks_.try_emplace(record_id);
+      auto& held = held_it->second;
+      if (inserted) {
+        held.shard = &generic_mutex_ptr_->GetShard(record_id);
+      }
+      UniqueLock lock(held.shard->latch);
+      if (inserted) {
+        held.entry = &held.shard->table[record_id];
+      }
+      if (generic_mutex_ptr_->AcquireLock(
+              lock, *held.shard, *held.entry, record_id, transaction_id_, mode,
+              std::nullopt, false) != LockStatus::GRANTED) {
+        if (inserted) {
+          held_locks_.erase(held_it);
+        }
+        return false;
+      }
+      ++held.hold_count;
+      return true;
+    }
+
+    /**
+     * @brief Try to acquire a lock on a record with the given identifier
+     * without blocking, just like `GenericMutex::TryLock`.
+     *
+     * @param record_id Constant reference to the record identifier.
+     * @param mode Constant reference to the lock mode.
+     * @returns `true` if the lock is successfully acquired, otherwise `false`.
+     */
+    bool TryLock(const RecordId& record_id, const LockMode& mode) {
+      if (generic_mutex_ptr_->ConsumeWound(transaction_id_)) {
+        return false;
+      }
+
+      auto [held_it, inserted] = held_locks_.try_emplace(record_id);
+      auto& held = held_it->second;
+      if (inserted) {
+        held.shard = &generic_mutex_ptr_->GetShard(record_id);
+      }
+      LockGuard guard(held.shard->latch);
+      if (inserted) {
+        held.entry = &held.shard->table[record_id];
+      }
+      if (!generic_mutex_ptr_
+               ->MakeLockRequest(*held.shard, *held.entry, record_id,
+                                 transaction_id_, mode, false, false)
+               .value_or(false)) {
+        if (inserted) {
+          held_locks_.erase(held_it);
+        }
+        return false;
+      }
+      ++held.hold_count;
+      return true;
+    }
+
+    /**
+     * @brief Release one acquisition of the lock on a record with the given
+     * identifier made through the handle. No operation is performed if the
+     * handle holds no lock on the record.
+     *
+     * @param record_id Constant reference to the record identifier.
+     */
+    void Unlock(const RecordId& record_id) {
+      auto held_it = held_locks_.find(record_id);
+      if (held_it == held_locks_.end()) {
+        return;
+      }
+      auto held = held_it->second;
+      if (--held_it->second.hold_count == 0) {
+        held_locks_.erase(held_it);
+      }
+      UniqueLock lock(held.shard->latch);
+      bool granted = generic_mutex_ptr_->ReleaseLock(
+          *held.shard, *held.entry, record_id, transaction_id_, false, false);
+      if (generic_mutex_ptr_->IsUnused(*held.entry)) {
+        held.shard->table.erase(record_id);
+      }
+      lock.unlock();
+      if (granted) {
+        generic_mutex_ptr_->RunCompletions();
+      }
+      if (held_locks_.empty()) {
+        generic_mutex_ptr_->ClearWound(transaction_id_);
+      }
+    }
+
+    /**
+     * @brief Release all the locks held through the handle. The locks are
+     * grouped by shard, so the latch of each shard is acquired only once.
+     *
+     */
+    void UnlockAll() {
+      if (held_locks_.empty()) {
+        return;
+      }
+      std::vector<std::pair<const RecordId*, const HeldLock*>> locks;
+      locks.reserve(held_locks_.size());
+      for (auto& [record_id, held] : held_locks_) {
+        locks.emplace_back(&record_id, &held);
+      }
+      std::sort(locks.begin(), locks.end(),
+                [](const auto& lhs, const auto& rhs) {
+                  return std::less<LockTableShard*>()(lhs.second->shard,
+                                                      rhs.second->shard);
+                });
+      bool granted = false;
+      for (auto it = locks.begin(); it != locks.end();) {
+        auto& shard = *it->second->shard;
+        LockGuard guard(shard.latch);
+        for (; it != locks.end() && it->second->shard == &shard; ++it) {
+          auto& entry = *it->second->entry;
+          granted |= generic_mutex_ptr_->ReleaseLock(
+              shard, entry, *it->first, transaction_id_, true, false);
+          if (generic_mutex_ptr_->IsUnused(entry)) {
+            shard.table.erase(*it->first);
+          }
+        }
+      }
+      held_locks_.clear();
+      if (granted) {
+        generic_mutex_ptr_->RunCompletions();
+      }
+      generic_mutex_ptr_->ClearWound(transaction_id_);
+    }
+
+   private:
+    friend class GenericMutex;
 
-      // TODO: [OPTIMIZATION] Design an approach to just wakeup the
-      // transaction associated with the denied request. This avoids
-      // unnecessary wakeup of other threads.
+    // Lock held through the handle on a record, along with the shard and lock
+    // table entry of the record and the number of times it was acquired
+    // through the handle.
+    struct HeldLock {
+      LockTableShard* shard = nullptr;
+      LockTableEntry* entry = nullptr;
+      size_t hold_count = 0;
+    };
+
+    /**
+     * @brief Construct a new Transaction object.
+     *
+     * @param generic_mutex Reference to the generic mutex to lock.
+     * @param transaction_id Constant reference to the transaction identifier.
+     */
+    Transaction(GenericMutex& generic_mutex,
+                const TransactionId& transaction_id)
+        : generic_mutex_ptr_(&generic_mutex),
+          transaction_id_(transaction_id),
+          held_locks_() {}
+
+    /**
+     * @brief Release all the locks held through the handle, unless the handle
+     * was moved from.
+     *
+     */
+    void End() {
+      if (generic_mutex_ptr_ != nullptr) {
+        UnlockAll();
+      }
+    }
 
-      // Deny the waiting request of `_thread_id` identifier and notify all the
-      // waiting threads in the queue.
-      auto& _record_id = wait_map_.at(_thread_id);
-      auto& entry = table_.at(_record_id);
-      entry.queue.GetLockRequest(_thread_id).Deny();
-      entry.cv.NotifyAll();
+    GenericMutex* generic_mutex_ptr_;
+    TransactionId transaction_id_;
+    // Locks held through the handle, by record identifier.
+    std::unordered_map<RecordId, HeldLock> held_locks_;
+  };
+
+  /**
+   * @brief Begin a transaction with the given identifier, returning a handle
+   * through which it locks records of the mutex. At most one handle should
+   * exist for a transaction at a time.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns The transaction handle.
+   */
+  Transaction BeginTransaction(const TransactionId& transaction_id) {
+    return Transaction(*this, transaction_id);
+  }
+
+ private:
+  /**
+   * @brief Acquire a lock on a record with the given identifier, waiting at
+   * most till the given deadline if any. A request whose deadline is reached
+   * is removed from the request queue and the dependency graph.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param deadline Constant reference to the optional deadline.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns Status of the lock request.
+   */
+  LockStatus AcquireLock(LockTableShard& shard, const RecordId& record_id,
+                         const TransactionId& transaction_id,
+                         const LockMode& mode,
+                         const std::optional<Deadline>& deadline,
+                         bool indexed) {
+    if (ConsumeWound(transaction_id)) {
+      return LockStatus::DENIED;
+    }
+
+    UniqueLock lock(shard.latch);
+    // Creates a lock table entry if it does not exist already
+    auto& entry = shard.table[record_id];
+    return AcquireLock(lock, shard, entry, record_id, transaction_id, mode,
+                       deadline, indexed);
+  }
+
+  /**
+   * @brief Acquire a lock on a record in the given lock table entry, waiting
+   * at most till the given deadline if any.
+   *
+   * @note The caller should hold the latch of the given shard through the given
+   * lock.
+   *
+   * @param lock Reference to the lock holding the latch of the shard.
+   * @param shard Reference to the shard containing the record.
+   * @param entry Reference to the lock table entry of the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param deadline Constant reference to the optional deadline.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns Status of the lock request.
+   */
+  LockStatus AcquireLock(UniqueLock& lock, LockTableShard& shard,
+                         LockTableEntry& entry, const RecordId& record_id,
+                         const TransactionId& transaction_id,
+                         const LockMode& mode,
+                         const std::optional<Deadline>& deadline,
+                         bool indexed) {
+    if (auto granted = MakeLockRequest(shard, entry, record_id, transaction_id,
+                                       mode, true, indexed)) {
+      return *granted ? LockStatus::GRANTED : LockStatus::DENIED;
+    }
+
+    // The transaction needs to wait till the request can be granted.
+    details::ConditionVariable cv;
+    Waiter waiter = &cv;
+    if (!EnqueueLockRequest(lock, shard, entry, record_id, transaction_id,
+                            waiter, indexed)) {
+      return LockStatus::DENIED;
+    }
+    return WaitForLockRequest(lock, shard, entry, record_id, transaction_id, cv,
+                              deadline, indexed);
+  }
+
+  /**
+   * @brief Sort the given lock requests on multiple records into a canonical
+   * order, by the shard of their records, the hash of their identifiers and
+   * then their identifiers, so that records with colliding hashes are ordered
+   * alike by every transaction. Requests on the same record retain their
+   * relative order.
+   *
+   * @param requests Constant reference to the identifiers of the records along
+   * with the requested lock modes.
+   * @returns The hash of the record identifier of each request along with the
+   * position of the request, in canonical order.
+   */
+  std::vector<std::pair<size_t, size_t>> OrderRequests(
+      const std::vector<std::pair<RecordId, LockMode>>& requests) const {
+    std::vector<std::pair<size_t, size_t>> order;
+    order.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+      order.emplace_back(std::hash<RecordId>()(requests[i].first), i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&requests](const auto& lhs, const auto& rhs) {
+                       if (lhs.first % shards_count !=
+                           rhs.first % shards_count) {
+                         return lhs.first % shards_count <
+                                rhs.first % shards_count;
+                       }
+                       if (lhs.first != rhs.first) {
+                         return lhs.first < rhs.first;
+                       }
+                       return std::less<RecordId>()(
+                           requests[lhs.second].first,
+                           requests[rhs.second].first);
+                     });
+    return order;
+  }
+
+  /**
+   * @brief Acquire a lock on a record with the given identifier only if it can
+   * be granted right away. Otherwise nothing is left behind in the request
+   * queue or the dependency graph.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @param overflow Flag indicating if a request overflowing the full holder
+   * set of an uncontended record is granted by building its request queue.
+   * Otherwise the request is reported as having to wait, so that releasing the
+   * lock again does not leave the record with a request queue.
+   * @returns `true` if the lock is acquired, `false` if the request is denied
+   * as the transaction already has a request on the record, and null if the
+   * request would have to wait.
+   */
+  std::optional<bool> TryAcquireLock(LockTableShard& shard,
+                                     const RecordId& record_id,
+                                     const TransactionId& transaction_id,
+                                     const LockMode& mode, bool indexed,
+                                     bool overflow) {
+    auto& entry = shard.table[record_id];
+    if (!overflow && entry.queue.Empty() &&
+        entry.holders.Size() == uncontended_holders_count &&
+        !entry.holders.FindHolder(transaction_id)) {
+      return std::nullopt;
+    }
+    return MakeLockRequest(shard, entry, record_id, transaction_id, mode, false,
+                           indexed);
+  }
+
+  /**
+   * @brief Make the lock request of a transaction on a record with the given
+   * identifier, granting it right away if possible. A lock already held by the
+   * transaction is acquired once more, without touching the request queue, if
+   * it covers the requested mode. Locks on uncontended records are granted
+   * through the holder set without building the request queue. A request which
+   * can not be granted right away is either left waiting in the queue, to be
+   * enqueued by `EnqueueLockRequest`, or removed.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param entry Reference to the lock table entry of the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param wait Flag indicating if a request which can not be granted right
+   * away is left in the queue.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns `true` if the lock is acquired, `false` if the request is denied
+   * as the transaction already has a request on the record, and null if the
+   * request has to wait.
+   */
+  std::optional<bool> MakeLockRequest(LockTableShard& shard,
+                                      LockTableEntry& entry,
+                                      const RecordId& record_id,
+                                      const TransactionId& transaction_id,
+                                      const LockMode& mode, bool wait,
+                                      bool indexed) {
+    if (auto reacquired = Reacquire(entry, transaction_id, mode)) {
+      return reacquired;
+    }
+    if (entry.queue.Empty()) {
+      if (entry.holders.EmplaceHolder(transaction_id, mode,
+                                      GetContentionTable())) {
+        if (indexed) {
+          IndexRecord(shard, record_id, transaction_id);
+        }
+        return true;
+      }
+      // The request queue is built only if the request is granted in it or
+      // is going to wait. A holder is denied right away, its request being
+      // denied in the queue as well.
+      if (entry.holders.FindHolder(transaction_id)) {
+        return false;
+      }
+      if (!wait && entry.holders.Contends(mode, GetContentionTable())) {
+        return std::nullopt;
+      }
+      MoveHoldersToQueue(entry);
+    }
+
+    // Emplace request in the queue of the record identifier
+    auto& group_id = entry.queue.EmplaceLockRequest(transaction_id, mode,
+                                                    GetContentionTable());
+    // If the request could not be emplaced then return
+    if (group_id == LockRequestQueue::null_group_id) {
+      return false;
+    }
+    // If the emplaced request belong to the granted group then return as the
+    // lock has been granted successfully.
+    if (group_id == entry.granted_group_id) {
+      if (indexed) {
+        IndexRecord(shard, record_id, transaction_id);
+      }
+      return true;
+    }
+    if (!wait) {
+      entry.queue.RemoveLockRequest(transaction_id);
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Enqueue the waiting lock request of a transaction on a record with
+   * the given identifier, made by `MakeLockRequest`. When deadlocks are
+   * prevented, the request is either denied right away or the conflicting
+   * transactions are wounded. Otherwise the waiter is registered along with
+   * the dependencies of the request. Deadlocks closed by the request are
+   * recovered from right away under the `DetectOnWaitPolicy`, and under the
+   * `DetectOnTimeoutPolicy` for asynchronous requests since no thread wakes up
+   * periodically on their behalf. Recovery goes on till no cycle is left in
+   * the dependency graph, or till the state of a victim changes while it is
+   * being denied, in which case the remaining deadlocks are left to the
+   * periodic checks of the waiting transactions.
+   *
+   * @note The caller should hold the latch of the given shard. The latch is
+   * temporarily released while wounding transactions or recovering from a
+   * deadlock, so an asynchronous request might be completed already once the
+   * method returns.
+   *
+   * @param lock Reference to the lock holding the latch of the shard.
+   * @param shard Reference to the shard containing the record.
+   * @param entry Reference to the lock table entry of the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param waiter Reference to the waiter of the request. The waiter is moved
+   * into the lock table entry, and moved back if the request is denied.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns `true` if the request is waiting, `false` if it is denied and
+   * removed from the queue.
+   */
+  bool EnqueueLockRequest(UniqueLock& lock, LockTableShard& shard,
+                          LockTableEntry& entry, const RecordId& record_id,
+                          const TransactionId& transaction_id, Waiter& waiter,
+                          bool indexed) {
+    if constexpr (std::is_same_v<DeadlockPolicy, NoWaitPolicy>) {
+      entry.queue.RemoveLockRequest(transaction_id);
+      return false;
+    } else if constexpr (std::is_same_v<DeadlockPolicy, WaitDiePolicy>) {
+      if (WaitsOnOlderTransaction(entry.queue, transaction_id)) {
+        entry.queue.RemoveLockRequest(transaction_id);
+        return false;
+      }
+    }
+
+    // The waiter is registered before the latch might be released while
+    // wounding or recovering, so that the request is completed by whichever
+    // thread grants or denies it.
+    bool asynchronous = std::holds_alternative<Callback>(waiter);
+    entry.waiters[transaction_id] = std::move(waiter);
+    if (indexed) {
+      IndexRecord(shard, record_id, transaction_id);
+    }
+    bool deadlocked = false;
+    if constexpr (std::is_same_v<DeadlockPolicy, WoundWaitPolicy>) {
+      if (!WoundYoungerTransactions(lock, entry, record_id, transaction_id)) {
+        waiter = std::move(entry.waiters[transaction_id]);
+        entry.waiters.erase(transaction_id);
+        entry.queue.RemoveLockRequest(transaction_id);
+        if (indexed) {
+          UnindexRecord(shard, record_id, transaction_id);
+        }
+        return false;
+      }
+    } else if constexpr (detects_deadlocks) {
+      // The transaction is dependent on the prior requests to be granted.
+      LockGuard graph_guard(graph_latch_);
+      InsertDependency(entry.queue, record_id, transaction_id);
+      wait_map_[transaction_id] = record_id;
+      if (std::is_same_v<DeadlockPolicy, DetectOnWaitPolicy> ||
+          (std::is_same_v<DeadlockPolicy, DetectOnTimeoutPolicy> &&
+           asynchronous)) {
+        deadlocked = dependency_graph_.HasCycle();
+      }
+    }
+    if (deadlocked) {
+      RecoverFromDeadlocks(lock);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Wait for the lock request of a transaction on a record with the
+   * given identifier to be granted, at most till the given deadline if any.
+   * The request is removed from the request queue and the dependency graph if
+   * it is denied or its deadline is reached.
+   *
+   * @param lock Reference to the lock holding the latch of the shard.
+   * @param shard Reference to the shard containing the record.
+   * @param entry Reference to the lock table entry of the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param cv Reference to the condition variable the transaction is
+   * registered to wait on by `EnqueueLockRequest`.
+   * @param deadline Constant reference to the optional deadline.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns Status of the lock request.
+   */
+  LockStatus WaitForLockRequest(UniqueLock& lock, LockTableShard& shard,
+                                LockTableEntry& entry,
+                                const RecordId& record_id,
+                                const TransactionId& transaction_id,
+                                details::ConditionVariable& cv,
+                                const std::optional<Deadline>& deadline,
+                                bool indexed) {
+    auto stop_waiting = std::bind(&GenericMutex::StopWaiting, this,
+                                  std::cref(shard), record_id, transaction_id);
+    bool expired = false;
+    // Completions queued while enqueueing the request are run before waiting.
+    RunCompletions(lock);
+    if constexpr (checks_on_timeout) {
+      auto deadlock_check =
+          std::bind(&GenericMutex::DeadlockCheck, this, std::ref(lock),
+                    record_id, transaction_id);
+      if (deadline) {
+        expired = !cv.WaitUntil(lock, *deadline, timeout_, deadlock_check,
+                                stop_waiting);
+      } else {
+        cv.Wait(lock, timeout_, deadlock_check, stop_waiting);
+      }
+    } else {
+      if (deadline) {
+        expired = !cv.WaitUntil(lock, *deadline, stop_waiting);
+      } else {
+        cv.Wait(lock, stop_waiting);
+      }
+    }
+    entry.waiters.erase(transaction_id);
+
+    // The granted request might have been released by `UnlockAll` before the
+    // transaction woke up, in which case it is reported as denied.
+    if (!entry.queue.LockRequestExists(transaction_id)) {
+      if constexpr (tracks_waiters) {
+        LockGuard graph_guard(graph_latch_);
+        wait_map_.erase(transaction_id);
+      }
+      if (IsUnused(entry)) {
+        shard.table.erase(record_id);
+      }
+      return LockStatus::DENIED;
+    }
+
+    // Check if the request was denied. Happens on deadlock discovery, when
+    // the transaction is wounded or when its locks are released by
+    // `UnlockAll`. A request whose deadline is reached is removed just like a
+    // denied request.
+    bool denied = entry.queue.GetLockRequest(transaction_id).IsDenied();
+    bool removed = denied || expired;
+    if constexpr (tracks_waiters) {
+      LockGuard graph_guard(graph_latch_);
+      wait_map_.erase(transaction_id);
+      if constexpr (detects_deadlocks) {
+        // Permform cleanup by removing all the dependencies existing in the
+        // dependency graph for the transaction. Note that all the
+        // dependent/depended requests of the denied request will exist only in
+        // the current queue. We dont need to check queues associated with the
+        // other record identifiers.
+        if (removed) {
+          RemoveDependency(entry.queue, record_id, transaction_id);
+        }
+      } else if (denied) {
+        // The denied request reports the wound of the transaction.
+        EraseWound(transaction_id);
+      }
+    }
+    if (removed) {
+      // Remove the lock request from the queue. The denied request might have
+      // been part of the granted group if the prior requests were unlocked
+      // before the transaction woke up. The next group is thus granted if
+      // needed. Removing a waiting request can also leave the requests behind
+      // it free of contention with the granted group.
+      entry.queue.RemoveLockRequest(transaction_id);
+      if (indexed) {
+        UnindexRecord(shard, record_id, transaction_id);
+      }
+      if (IsUnused(entry)) {
+        shard.table.erase(record_id);
+      } else if (!entry.queue.Empty()) {
+        GrantFrontGroup(entry);
+        GrantCompatibleRequests(entry, record_id);
+        lock.unlock();
+        RunCompletions();
+      }
+
+      return denied ? LockStatus::DENIED : LockStatus::TIMEOUT;
+    }
+
+    return LockStatus::GRANTED;
+  }
+
+  /**
+   * @brief Release the lock held by a transaction on a record with the given
+   * identifier, either once or fully irrespective of its hold count. The lock
+   * table entry of the record is removed once it is no longer used.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param fully Flag indicating if the lock is released fully.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns `true` if waiting requests might have been granted else `false`.
+   */
+  bool ReleaseLock(LockTableShard& shard, const RecordId& record_id,
+                   const TransactionId& transaction_id, bool fully,
+                   bool indexed) {
+    // Check if an entry exists in the lock table for the given record
+    // identifier.
+    auto table_it = shard.table.find(record_id);
+    if (table_it == shard.table.end()) {
+      return false;
+    }
+    bool granted = ReleaseLock(shard, table_it->second, record_id,
+                               transaction_id, fully, indexed);
+    if (IsUnused(table_it->second)) {
+      shard.table.erase(table_it);
+    }
+    return granted;
+  }
+
+  /**
+   * @brief Release the lock held by a transaction in the given lock table
+   * entry, either once or fully irrespective of its hold count. The next
+   * request group is granted if the released lock was the last one held in
+   * the granted group. The entry is left in the lock table.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param entry Reference to the lock table entry of the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param fully Flag indicating if the lock is released fully.
+   * @param indexed Flag indicating if the record is tracked in the transaction
+   * index of the shard.
+   * @returns `true` if waiting requests might have been granted else `false`.
+   */
+  bool ReleaseLock(LockTableShard& shard, LockTableEntry& entry,
+                   const RecordId& record_id,
+                   const TransactionId& transaction_id, bool fully,
+                   bool indexed) {
+    // Uncontended records have no dependencies or waiters to take care of.
+    if (entry.queue.Empty()) {
+      if (fully ? entry.holders.RemoveHolder(transaction_id)
+                : entry.holders.ReleaseHold(transaction_id)) {
+        if (indexed) {
+          UnindexRecord(shard, record_id, transaction_id);
+        }
+      }
+      return false;
+    }
+
+    // Check if a granted lock request exists in the queue.
+    if (!entry.queue.LockRequestExists(transaction_id) ||
+        entry.queue.GetGroupId(transaction_id) != entry.granted_group_id) {
+      return false;
+    }
+    // The lock is still held if acquired multiple times.
+    if (!fully &&
+        entry.queue.GetLockRequest(transaction_id).ReleaseHold() > 0) {
+      return false;
+    }
+    // Remove all dependencies for the given transaction identifier.
+    if constexpr (detects_deadlocks) {
+      LockGuard graph_guard(graph_latch_);
+      RemoveDependency(entry.queue, record_id, transaction_id);
+      // Pending conversions no longer wait on the transaction.
+      auto& group = entry.queue.Begin()->value;
+      if (group.HasConversions()) {
+        for (auto it = group.Begin(); it != group.End(); ++it) {
+          dependency_graph_.Remove(it->key, transaction_id);
+        }
+      }
+    }
+    // Remove the lock request from the queue
+    entry.queue.RemoveLockRequest(transaction_id);
+    if (indexed) {
+      UnindexRecord(shard, record_id, transaction_id);
+    }
+    // Check if no more lock requests pending
+    if (entry.queue.Empty()) {
+      return false;
+    }
+    // The request queue is not empty so we now check if all the granted locks
+    // have been unlocked. If so, we can wakeup the waiting threads associated
+    // with the next request group. Otherwise some of the granted lock requests
+    // are still not unlocked so nothing is done.
+    GrantFrontGroup(entry);
+    return true;
+  }
+
+  /**
+   * @brief Release all the locks held by a transaction in the lock table entry
+   * pointed to by the given iterator. The waiting request or pending
+   * conversion of the transaction is denied first, so that a thread of the
+   * transaction blocked on it wakes up. The entry is removed once it is no
+   * longer used, which is deferred to the woken up thread.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param table_it Iterator to the lock table entry of the record.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns Iterator to the entry following the given entry.
+   */
+  typename LockTable::iterator ReleaseAllLocks(
+      LockTableShard& shard, typename LockTable::iterator table_it,
+      const TransactionId& transaction_id) {
+    auto& record_id = table_it->first;
+    auto& entry = table_it->second;
+    DenyLockRequest(entry, record_id, transaction_id);
+    ReleaseLock(shard, entry, record_id, transaction_id, true, true);
+    if (IsUnused(entry)) {
+      return shard.table.erase(table_it);
+    }
+    return std::next(table_it);
+  }
+
+  /**
+   * @brief Check if the given lock table entry is no longer used, i.e. it has
+   * neither holders, lock requests nor waiting transactions, so that it can be
+   * removed from the lock table.
+   *
+   * @param entry Constant reference to the lock table entry.
+   * @returns `true` if the entry is unused else `false`.
+   */
+  bool IsUnused(const LockTableEntry& entry) const {
+    return entry.queue.Empty() && entry.holders.Empty() &&
+           entry.waiters.empty();
+  }
+
+  /**
+   * @brief Record that a transaction holds or waits for a lock on a record
+   * with the given identifier. Only the `TransactionIndexPolicy` keeps such
+   * records.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void IndexRecord(LockTableShard& shard, const RecordId& record_id,
+                   const TransactionId& transaction_id) {
+    if constexpr (indexes_transactions) {
+      shard.index[transaction_id].insert(record_id);
+    }
+  }
+
+  /**
+   * @brief Record that a transaction no longer holds or waits for a lock on a
+   * record with the given identifier. No operation is performed if the record
+   * is not recorded for the transaction.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void UnindexRecord(LockTableShard& shard, const RecordId& record_id,
+                     const TransactionId& transaction_id) {
+    if constexpr (indexes_transactions) {
+      auto index_it = shard.index.find(transaction_id);
+      if (index_it == shard.index.end()) {
+        return;
+      }
+      if (index_it->second.erase(record_id) > 0 && index_it->second.empty()) {
+        shard.index.erase(index_it);
+      }
+    }
+  }
+
+  /**
+   * @brief Start the background deadlock detector if the
+   * `DetectInBackgroundPolicy` is used.
+   *
+   */
+  void StartDeadlockDetector() {
+    if constexpr (std::is_same_v<DeadlockPolicy, DetectInBackgroundPolicy>) {
+      detector_ = std::thread(&GenericMutex::DetectDeadlocks, this);
+    }
+  }
+
+  /**
+   * @brief Get the contention table. The table of a compile time contention
+   * policy is returned directly so that contention checks can be constant
+   * folded.
+   *
+   * @returns Constant reference to the contention table.
+   */
+  const details::ContentionTable<modes_count>& GetContentionTable() const {
+    if constexpr (runtime_contention) {
+      return contention_table_;
+    } else {
+      return ContentionPolicy::contention_table;
+    }
+  }
+
+  /**
+   * @brief Get the conversion table. The table of a compile time contention
+   * policy is returned directly so that lookups in it can be constant folded.
+   *
+   * @returns Constant reference to the conversion table.
+   */
+  const details::ConversionTable<modes_count>& GetConversionTable() const {
+    if constexpr (runtime_contention) {
+      return conversion_table_;
+    } else {
+      return ContentionPolicy::conversion_table;
+    }
+  }
+
+  /**
+   * @brief Get the lock mode a held lock is converted to when the given lock
+   * mode is requested.
+   *
+   * @param held Constant reference to the held lock mode.
+   * @param requested Constant reference to the requested lock mode.
+   * @returns The supremum of the lock modes, or null if they have none.
+   */
+  std::optional<LockMode> GetConversionMode(const LockMode& held,
+                                            const LockMode& requested) const {
+    auto supremum = GetConversionTable().Supremum(held, requested);
+    if (supremum == details::ConversionTable<modes_count>::null_mode) {
+      return std::nullopt;
+    }
+    return static_cast<LockMode>(supremum);
+  }
+
+  /**
+   * @brief Get the lock table shard containing the record with the given
+   * identifier.
+   *
+   * @param record_id Constant reference to the record identifier.
+   * @returns Reference to the lock table shard.
+   */
+  LockTableShard& GetShard(const RecordId& record_id) {
+    return shards_[std::hash<RecordId>()(record_id) % shards_count];
+  }
+
+  /**
+   * @brief Acquire once more the lock held by a transaction on the record
+   * associated with the given lock table entry, if the held lock mode covers
+   * the given lock mode. Only the hold count of the lock is incremented, the
+   * request queue is left untouched.
+   *
+   * @note The caller should hold the latch of the shard containing the entry.
+   *
+   * @param entry Reference to the lock table entry.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the requested lock mode.
+   * @returns `true` if the lock is acquired once more, `false` if the
+   * transaction holds a lock not covering the given mode or is still waiting
+   * for its lock, and null if the transaction has no request on the record.
+   */
+  std::optional<bool> Reacquire(LockTableEntry& entry,
+                                const TransactionId& transaction_id,
+                                const LockMode& mode) {
+    if (entry.queue.Empty()) {
+      auto holder = entry.holders.FindHolder(transaction_id);
+      if (!holder) {
+        return std::nullopt;
+      }
+      return GetConversionMode(holder->mode, mode) == holder->mode &&
+             entry.holders.AddHold(transaction_id);
+    }
+
+    if (!entry.queue.LockRequestExists(transaction_id)) {
+      return std::nullopt;
+    }
+    auto& request = entry.queue.GetLockRequest(transaction_id);
+    if (entry.queue.GetGroupId(transaction_id) != entry.granted_group_id ||
+        request.IsDenied() ||
+        GetConversionMode(request.GetMode(), mode) != request.GetMode()) {
+      return false;
+    }
+    request.AddHold();
+    return true;
+  }
+
+  /**
+   * @brief Move the holders of the uncontended record associated with the given
+   * lock table entry to its request queue. Being compatible with each other,
+   * the holders form the front request group of the queue which is granted.
+   * The hold counts of the holders are carried over to their requests.
+   *
+   * @note The caller should hold the latch of the shard containing the entry.
+   *
+   * @param entry Reference to the lock table entry with an empty queue.
+   */
+  void MoveHoldersToQueue(LockTableEntry& entry) {
+    for (auto it = entry.holders.Begin(); it != entry.holders.End(); ++it) {
+      entry.queue.EmplaceLockRequest(it->transaction_id, it->mode,
+                                     GetContentionTable());
+      entry.queue.GetLockRequest(it->transaction_id)
+          .SetHoldCount(it->hold_count);
+    }
+    entry.holders.Clear();
+  }
+
+  /**
+   * @brief Grant the front request group in the queue of the given lock table
+   * entry if not granted already. Only the transactions waiting on the requests
+   * of the newly granted group are notified. If the front group is granted
+   * already, its pending conversions are granted instead where possible.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch. Notifying while holding the latch guarantees that
+   * the condition variable of a waiting transaction is not destroyed before
+   * being notified.
+   *
+   * @param entry Reference to the non-empty lock table entry.
+   */
+  void GrantFrontGroup(LockTableEntry& entry) {
+    auto& front_group = *entry.queue.Begin();
+    if (front_group.key == entry.granted_group_id) {
+      GrantConversions(entry);
+      return;
+    }
+    entry.granted_group_id = front_group.key;
+    for (auto it = front_group.value.Begin(); it != front_group.value.End();
+         ++it) {
+      NotifyGranted(entry, it->key);
+    }
+  }
+
+  /**
+   * @brief Grant the pending conversions in the granted group of the given lock
+   * table entry which no longer contend with the other requests in the group.
+   * Only the transactions waiting on the granted conversions are notified,
+   * after their dependencies are removed.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch.
+   *
+   * @param entry Reference to the non-empty lock table entry.
+   */
+  void GrantConversions(LockTableEntry& entry) {
+    auto& group = entry.queue.Begin()->value;
+    if (!group.HasConversions()) {
+      return;
+    }
+    // A granted conversion only adds contention, so a single pass suffices.
+    for (auto it = group.Begin(); it != group.End(); ++it) {
+      if (it->value.IsConverting() &&
+          group.ConvertLockRequest(it->key, it->value.GetConversionMode(),
+                                   GetContentionTable())) {
+        if constexpr (detects_deadlocks) {
+          LockGuard graph_guard(graph_latch_);
+          RemoveConversionDependency(entry.queue, it->key);
+        }
+        NotifyGranted(entry, it->key);
+      }
+    }
+  }
+
+  /**
+   * @brief Grant the waiting requests of the given lock table entry which no
+   * longer contend with the granted group, by moving them into the granted
+   * group. Only the requests in the group right after the granted group are
+   * considered, so that no request is granted ahead of a contending request
+   * made before it. The following group is considered once the group is left
+   * empty. No request is granted while a conversion is pending.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch.
+   *
+   * @param entry Reference to the non-empty lock table entry.
+   * @param record_id Constant reference to the record identifier.
+   */
+  void GrantCompatibleRequests(LockTableEntry& entry,
+                               const RecordId& record_id) {
+    auto& granted_group = entry.queue.Begin()->value;
+    while (std::next(entry.queue.Begin()) != entry.queue.End()) {
+      auto& group = std::next(entry.queue.Begin())->value;
+      bool emptied = false;
+      for (auto it = group.Begin(); it != group.End();) {
+        auto request_it = it++;
+        if (request_it->value.IsDenied() ||
+            granted_group.Contends(request_it->value.GetMode(),
+                                   GetContentionTable())) {
+          continue;
+        }
+        emptied = group.Size() == 1;
+        auto transaction_id = request_it->key;
+        if constexpr (detects_deadlocks) {
+          // The request is dependent on the granted group no more. It is now a
+          // part of the granted group instead.
+          LockGuard graph_guard(graph_latch_);
+          RemoveDependency(entry.queue, record_id, transaction_id);
+          entry.queue.PromoteLockRequest(transaction_id, GetContentionTable());
+          auto next_group_it = std::next(entry.queue.Begin());
+          if (next_group_it != entry.queue.End()) {
+            dependency_graph_.Add(
+                RecordGroup(record_id, entry.queue.Begin()->key),
+                transaction_id);
+          }
+        } else {
+          entry.queue.PromoteLockRequest(transaction_id, GetContentionTable());
+        }
+        NotifyGranted(entry, transaction_id);
+        if (emptied) {
+          break;
+        }
+      }
+      if (!emptied) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Deny the waiting lock request of the given transaction identifier
+   * in the queue of the given lock table entry. The dependencies of the denied
+   * request are removed right away so that the resolved deadlock is not
+   * discovered again by other transactions. Only the transaction associated
+   * with the denied request is notified. A pending conversion of a granted
+   * request is denied likewise, the transaction retaining its held lock. No
+   * operation is performed if the transaction has neither a waiting request
+   * nor a pending conversion in the queue.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch.
+   *
+   * @param entry Reference to the lock table entry.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the request is denied else `false`.
+   */
+  bool DenyLockRequest(LockTableEntry& entry, const RecordId& record_id,
+                       const TransactionId& transaction_id) {
+    if (!entry.queue.LockRequestExists(transaction_id)) {
+      return false;
+    }
+    if (entry.queue.GetGroupId(transaction_id) == entry.granted_group_id) {
+      auto& group = entry.queue.Begin()->value;
+      if (!group.GetLockRequest(transaction_id).IsConverting()) {
+        return false;
+      }
+      group.EndConversion(transaction_id);
+      if constexpr (detects_deadlocks) {
+        LockGuard graph_guard(graph_latch_);
+        RemoveConversionDependency(entry.queue, transaction_id);
+      }
+    } else {
+      entry.queue.DenyLockRequest(transaction_id);
+      if constexpr (detects_deadlocks) {
+        LockGuard graph_guard(graph_latch_);
+        RemoveDependency(entry.queue, record_id, transaction_id);
+      }
+    }
+    if (NotifyDenied(entry, transaction_id)) {
+      UnindexRecord(GetShard(record_id), record_id, transaction_id);
+      // Removing the waiting request can leave the requests behind it free of
+      // contention with the granted group.
+      GrantCompatibleRequests(entry, record_id);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Notify the transaction waiting on its lock request in the given lock
+   * table entry that the request is granted. A blocked transaction is woken
+   * up. An asynchronous request is completed right away instead, queueing its
+   * callback to be run once the latches are released. No operation is
+   * performed if the transaction is not waiting.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch.
+   *
+   * @param entry Reference to the lock table entry.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void NotifyGranted(LockTableEntry& entry,
+                     const TransactionId& transaction_id) {
+    auto waiter_it = entry.waiters.find(transaction_id);
+    if (waiter_it == entry.waiters.end()) {
+      return;
+    }
+    if (auto cv = std::get_if<details::ConditionVariable*>(
+            &waiter_it->second)) {
+      (*cv)->NotifyOne();
+      return;
+    }
+    auto callback = std::move(std::get<Callback>(waiter_it->second));
+    entry.waiters.erase(waiter_it);
+    if constexpr (tracks_waiters) {
+      LockGuard graph_guard(graph_latch_);
+      wait_map_.erase(transaction_id);
+    }
+    QueueCompletion(std::move(callback), true);
+  }
+
+  /**
+   * @brief Notify the transaction waiting on its lock request in the given lock
+   * table entry that the request is denied. A blocked transaction is woken up.
+   * An asynchronous request is completed right away instead, removing it from
+   * the queue and queueing its callback to be run once the latches are
+   * released. The dependencies of the request should already be removed. No
+   * operation is performed if the transaction is not waiting.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch. Since only waiting requests are made
+   * asynchronously, the queue is never left empty.
+   *
+   * @param entry Reference to the lock table entry.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the request is removed from the queue else `false`.
+   */
+  bool NotifyDenied(LockTableEntry& entry,
+                    const TransactionId& transaction_id) {
+    auto waiter_it = entry.waiters.find(transaction_id);
+    if (waiter_it == entry.waiters.end()) {
+      return false;
+    }
+    if (auto cv = std::get_if<details::ConditionVariable*>(
+            &waiter_it->second)) {
+      (*cv)->NotifyOne();
+      return false;
+    }
+    auto callback = std::move(std::get<Callback>(waiter_it->second));
+    entry.waiters.erase(waiter_it);
+    if constexpr (tracks_waiters) {
+      LockGuard graph_guard(graph_latch_);
+      wait_map_.erase(transaction_id);
+      if constexpr (!detects_deadlocks) {
+        // The denied request reports the wound of the transaction.
+        EraseWound(transaction_id);
+      }
+    }
+    entry.queue.RemoveLockRequest(transaction_id);
+    QueueCompletion(std::move(callback), false);
+    return true;
+  }
+
+  /**
+   * @brief Queue the callback of a completed asynchronous lock request to be
+   * run once the latches are released.
+   *
+   * @param callback The callback of the request.
+   * @param granted Flag indicating if the request is granted.
+   */
+  void QueueCompletion(Callback callback, bool granted) {
+    LockGuard guard(completion_latch_);
+    completions_.emplace_back(std::move(callback), granted);
+  }
+
+  /**
+   * @brief Run the callbacks of the completed asynchronous lock requests.
+   *
+   * @note The caller should hold no latch, so that the callbacks are free to
+   * make requests on the mutex.
+   */
+  void RunCompletions() {
+    std::vector<Completion> completions;
+    {
+      LockGuard guard(completion_latch_);
+      completions.swap(completions_);
+    }
+    for (auto& completion : completions) {
+      completion.first(completion.second);
+    }
+  }
+
+  /**
+   * @brief Run the callbacks of the completed asynchronous lock requests, if
+   * any, releasing the latch held by the given lock meanwhile.
+   *
+   * @param lock Reference to the lock holding the latch of a shard.
+   */
+  void RunCompletions(UniqueLock& lock) {
+    {
+      LockGuard guard(completion_latch_);
+      if (completions_.empty()) {
+        return;
+      }
+    }
+    lock.unlock();
+    RunCompletions();
+    lock.lock();
+  }
+
+  /**
+   * @brief Insert dependency for the given transaction identifier requesting
+   * lock for a record associated with the given request queue.
+   *
+   * The dependencies are tracked at the granularity of request groups. Each
+   * group of the record is a node in the dependency graph depending on the
+   * requests in the group and on the group right before it. A waiting request
+   * thus only depends on the group right before its own group, transitively
+   * reaching all the requests it is waiting for. This keeps the number of
+   * dependencies inserted per request constant irrespective of the number of
+   * requests in the queue.
+   *
+   * @note This method is idempotent so its safe to make duplicate calls. The
+   * caller should hold the graph latch.
+   *
+   * @param queue Constant reference to the lock request queue.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void InsertDependency(const LockRequestQueue& queue,
+                        const RecordId& record_id,
+                        const TransactionId& transaction_id) {
+    auto group_it = queue.FindGroup(queue.GetGroupId(transaction_id));
+    DependencyNode group_node = RecordGroup(record_id, group_it->key);
+
+    // NOTE: The `Add` method is idempotent. This implies that duplicate
+    // calls to the method will have the desired null effect.
+    dependency_graph_.Add(group_node, transaction_id);
+    if (group_it == queue.Begin()) {
+      // Requests in the front group are not waiting on any other request.
+      return;
+    }
+
+    auto prior_group_it = std::prev(group_it);
+    DependencyNode prior_group_node =
+        RecordGroup(record_id, prior_group_it->key);
+    if (!dependency_graph_.IsDependent(group_node, prior_group_node)) {
+      // The first waiting request in the group links the group to the prior
+      // group. The requests in the prior group are linked to it as well since
+      // granted requests have no dependencies inserted on their own.
+      dependency_graph_.Add(group_node, prior_group_node);
+      for (auto request_it = prior_group_it->value.Begin();
+           request_it != prior_group_it->value.End(); ++request_it) {
+        dependency_graph_.Add(prior_group_node, request_it->key);
+      }
+    }
+    dependency_graph_.Add(transaction_id, prior_group_node);
+  }
+
+  /**
+   * @brief Remove dependency for the given transaction identifier having a lock
+   * request for a record associated with the given request queue. If the
+   * request is the last one in its group, the group is removed from the
+   * dependency graph and the group right after it is linked to the group right
+   * before it.
+   *
+   * @note This method removes dependencies only if they exist. Thus it is safe
+   * to make duplicate calls. The caller should hold the graph latch.
+   *
+   * @param queue Constant reference to the lock request queue.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void RemoveDependency(const LockRequestQueue& queue,
+                        const RecordId& record_id,
+                        const TransactionId& transaction_id) {
+    auto group_it = queue.FindGroup(queue.GetGroupId(transaction_id));
+    DependencyNode group_node = RecordGroup(record_id, group_it->key);
+
+    // NOTE: The `Remove` method only removes dependency if it exist. Thus
+    // duplicate calls to the method has the desired null effect.
+    dependency_graph_.Remove(group_node, transaction_id);
+    if (group_it != queue.Begin()) {
+      dependency_graph_.Remove(
+          transaction_id, RecordGroup(record_id, std::prev(group_it)->key));
+    }
+    if (group_it->value.Size() > 1) {
+      return;
+    }
+
+    // The group gets removed from the queue along with the request.
+    dependency_graph_.Remove(group_node);
+    auto next_group_it = std::next(group_it);
+    if (group_it == queue.Begin() || next_group_it == queue.End()) {
+      return;
+    }
+    DependencyNode prior_group_node =
+        RecordGroup(record_id, std::prev(group_it)->key);
+    dependency_graph_.Add(RecordGroup(record_id, next_group_it->key),
+                          prior_group_node);
+    for (auto request_it = next_group_it->value.Begin();
+         request_it != next_group_it->value.End(); ++request_it) {
+      dependency_graph_.Add(request_it->key, prior_group_node);
+    }
+  }
+
+  /**
+   * @brief Insert dependency for the given transaction identifier waiting on
+   * the conversion of its granted lock request in the given queue. The
+   * transaction directly depends on each transaction whose request contends
+   * with the conversion.
+   *
+   * @note The caller should hold the graph latch.
+   *
+   * @param queue Constant reference to the lock request queue.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if an inserted dependency closes a cycle else `false`.
+   */
+  bool InsertConversionDependency(const LockRequestQueue& queue,
+                                  const TransactionId& transaction_id) {
+    bool closes_cycle = false;
+    FindBlockingTransaction(queue, transaction_id,
+                            [&](const TransactionId& _transaction_id) {
+                              closes_cycle |= dependency_graph_.Add(
+                                  transaction_id, _transaction_id);
+                              return false;
+                            });
+    return closes_cycle;
+  }
+
+  /**
+   * @brief Remove dependency for the given transaction identifier on the other
+   * requests in the granted group of the given queue, inserted while waiting
+   * on a conversion.
+   *
+   * @note This method removes dependencies only if they exist. The caller
+   * should hold the graph latch.
+   *
+   * @param queue Constant reference to the lock request queue.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void RemoveConversionDependency(const LockRequestQueue& queue,
+                                  const TransactionId& transaction_id) {
+    auto& group = queue.Begin()->value;
+    for (auto it = group.Begin(); it != group.End(); ++it) {
+      dependency_graph_.Remove(transaction_id, it->key);
+    }
+  }
+
+  /**
+   * @brief Find a transaction the given transaction waits on in the given
+   * queue, i.e. satisfying the given predicate. A waiting request waits on all
+   * the requests in the groups before its own group, while a pending conversion
+   * waits on the other requests in the granted group contending with it.
+   *
+   * @tparam Predicate Type of the predicate.
+   * @param queue Constant reference to the lock request queue.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param predicate Predicate invoked on the identifiers of the transactions
+   * waited on, till it returns `true`.
+   * @returns `true` if the predicate is satisfied else `false`.
+   */
+  template <class Predicate>
+  bool FindBlockingTransaction(const LockRequestQueue& queue,
+                               const TransactionId& transaction_id,
+                               Predicate predicate) const {
+    auto& request = queue.GetLockRequest(transaction_id);
+    if (request.IsConverting()) {
+      auto& group = queue.Begin()->value;
+      for (auto it = group.Begin(); it != group.End(); ++it) {
+        if (it->key != transaction_id && !it->value.IsDenied() &&
+            GetContentionTable().Contends(
+                details::ContentionTable<modes_count>::Mask(
+                    it->value.GetMode()),
+                request.GetConversionMode()) &&
+            predicate(it->key)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    auto group_id = queue.GetGroupId(transaction_id);
+    for (auto group_it = queue.Begin(); group_it->key != group_id;
+         ++group_it) {
+      for (auto request_it = group_it->value.Begin();
+           request_it != group_it->value.End(); ++request_it) {
+        if (predicate(request_it->key)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Check if the given transaction would wait on any transaction older
+   * than itself in the given queue. Used by the wait-die policy.
+   *
+   * @param queue Constant reference to the lock request queue.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the transaction would wait on an older transaction else
+   * `false`.
+   */
+  bool WaitsOnOlderTransaction(const LockRequestQueue& queue,
+                               const TransactionId& transaction_id) const {
+    return FindBlockingTransaction(
+        queue, transaction_id, [&](const TransactionId& _transaction_id) {
+          return _transaction_id < transaction_id;
+        });
+  }
+
+  /**
+   * @brief Consume the wound of the given transaction, if any. A wounded
+   * transaction is aborted at its next lock request, so the request is to be
+   * denied. Always `false` unless the wound-wait policy is used.
+   *
+   * @note The caller should hold no latch. The graph latch is only acquired
+   * while some transaction is wounded.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the transaction was wounded else `false`.
+   */
+  bool ConsumeWound(const TransactionId& transaction_id) {
+    if constexpr (std::is_same_v<DeadlockPolicy, WoundWaitPolicy>) {
+      if (wounds_count_.load(std::memory_order_relaxed) == 0) {
+        return false;
+      }
+      LockGuard graph_guard(graph_latch_);
+      return EraseWound(transaction_id);
+    } else {
+      return false;
+    }
+  }
+
+  /**
+   * @brief Clear the wound of the given transaction, if any, once it neither
+   * holds nor waits for a lock on any record. The transaction has then aborted
+   * by releasing its locks, so its identifier can be reused by a new
+   * transaction. Used by the wound-wait policy.
+   *
+   * @note The caller should hold no latch. The latches of the shards are
+   * acquired one at a time, and only if the transaction is wounded.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void ClearWound(const TransactionId& transaction_id) {
+    if constexpr (std::is_same_v<DeadlockPolicy, WoundWaitPolicy>) {
+      if (wounds_count_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+      {
+        LockGuard graph_guard(graph_latch_);
+        if (wounded_.count(transaction_id) == 0) {
+          return;
+        }
+      }
+      for (auto& shard : shards_) {
+        LockGuard guard(shard.latch);
+        if (HasLockRequest(shard, transaction_id)) {
+          return;
+        }
+      }
+      LockGuard graph_guard(graph_latch_);
+      EraseWound(transaction_id);
+    }
+  }
+
+  /**
+   * @brief Wound the given transaction.
+   *
+   * @note The caller should hold the graph latch.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the transaction is newly wounded else `false`.
+   */
+  bool InsertWound(const TransactionId& transaction_id) {
+    if (!wounded_.insert(transaction_id).second) {
+      return false;
+    }
+    wounds_count_.store(wounded_.size(), std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Remove the wound of the given transaction, if any.
+   *
+   * @note The caller should hold the graph latch.
+   *
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the transaction was wounded else `false`.
+   */
+  bool EraseWound(const TransactionId& transaction_id) {
+    if (wounded_.erase(transaction_id) == 0) {
+      return false;
+    }
+    wounds_count_.store(wounded_.size(), std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Check if the given transaction holds or waits for a lock on any
+   * record of the given shard.
+   *
+   * @note The caller should hold the latch of the given shard.
+   *
+   * @param shard Constant reference to the shard.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if the transaction has a lock request in the shard else
+   * `false`.
+   */
+  bool HasLockRequest(const LockTableShard& shard,
+                      const TransactionId& transaction_id) const {
+    if constexpr (indexes_transactions) {
+      return shard.index.count(transaction_id) > 0;
+    } else {
+      for (auto& table_entry : shard.table) {
+        auto& entry = table_entry.second;
+        if (entry.queue.Empty()
+                ? entry.holders.FindHolder(transaction_id) != nullptr
+                : entry.queue.LockRequestExists(transaction_id)) {
+          return true;
+        }
+      }
+      return false;
+    }
+  }
+
+  /**
+   * @brief Wound the transactions younger than the given transaction which it
+   * waits on in the queue of the given lock table entry. The waiting requests
+   * and pending conversions of the wounded transactions are denied right away,
+   * while the wounded transactions holding locks are aborted at their next
+   * lock request. The given transaction is registered as waiting unless it has
+   * been wounded itself. Used by the wound-wait policy.
+   *
+   * @note The caller should hold the latch of the shard containing the entry
+   * but not the graph latch. The shard latch is temporarily released if a
+   * wounded transaction waits on a record belonging to another shard.
+   *
+   * @param lock Reference to the lock holding the latch of the shard
+   * containing the entry.
+   * @param entry Reference to the lock table entry.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `false` if the given transaction has been wounded, in which case
+   * no transaction is wounded, else `true`.
+   */
+  bool WoundYoungerTransactions(UniqueLock& lock, LockTableEntry& entry,
+                                const RecordId& record_id,
+                                const TransactionId& transaction_id) {
+    std::vector<WaitingTransaction> victims;
+    {
+      LockGuard graph_guard(graph_latch_);
+      // The transaction might have been wounded since the start of its request.
+      if (EraseWound(transaction_id)) {
+        return false;
+      }
+      wait_map_[transaction_id] = record_id;
+
+      FindBlockingTransaction(
+          entry.queue, transaction_id,
+          [&](const TransactionId& _transaction_id) {
+            if (transaction_id < _transaction_id &&
+                InsertWound(_transaction_id)) {
+              auto wait_it = wait_map_.find(_transaction_id);
+              if (wait_it != wait_map_.end()) {
+                victims.emplace_back(_transaction_id, wait_it->second);
+              }
+            }
+            return false;
+          });
+    }
+    for (auto& victim : victims) {
+      RecoverFromDeadlock(lock, victim);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Method to check if a transaction should stop waiting. A transaction
+   * can stop waiting if its lock request is granted or if the request is denied
+   * due to a deadlock discovery.
+   *
+   * @param shard Constant reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if transaction can stop wating else `false`.
+   */
+  bool StopWaiting(const LockTableShard& shard, const RecordId& record_id,
+                   const TransactionId& transaction_id) const {
+    auto& entry = shard.table.at(record_id);
+    // Stop waiting if the request is granted or it is denied due to discovery
+    // of a deadlock. The request is gone if it was granted and then released
+    // by `UnlockAll`.
+    return !entry.queue.LockRequestExists(transaction_id) ||
+           (entry.queue.GetGroupId(transaction_id) == entry.granted_group_id) ||
+           entry.queue.GetLockRequest(transaction_id).IsDenied();
+  }
+
+  /**
+   * @brief Method to check if a transaction should stop waiting on the
+   * conversion of its lock. A transaction can stop waiting once the conversion
+   * is either granted or denied.
+   *
+   * @param shard Constant reference to the shard containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @returns `true` if transaction can stop wating else `false`.
+   */
+  bool StopConverting(const LockTableShard& shard, const RecordId& record_id,
+                      const TransactionId& transaction_id) const {
+    // The request is gone if the lock was released by `UnlockAll`.
+    auto& queue = shard.table.at(record_id).queue;
+    return !queue.LockRequestExists(transaction_id) ||
+           !queue.GetLockRequest(transaction_id).IsConverting();
+  }
+
+  /**
+   * @brief Check for presence of a deadlock and perform recovery actions if it
+   * exists. The method is invoked periodically by waiting transactions when
+   * the `DetectOnTimeoutPolicy` is used, and as a backstop for the deadlocks
+   * left unresolved on wait when the `DetectOnWaitPolicy` is used.
+   *
+   * @param lock Reference to the lock holding the latch of the shard
+   * containing the record.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   */
+  void DeadlockCheck(UniqueLock& lock, const RecordId& record_id,
+                     const TransactionId& transaction_id) {
+    // Check if the request associated with the given transaction identifier is
+    // denied or released. In that case there is no need to run the deadlock
+    // check and we can simply return. This avoids unnecessary deadlock checks.
+    auto& queue = GetShard(record_id).table.at(record_id).queue;
+    if (!queue.LockRequestExists(transaction_id) ||
+        queue.GetLockRequest(transaction_id).IsDenied()) {
+      return;
+    }
+
+    std::optional<WaitingTransaction> victim;
+    {
+      LockGuard graph_guard(graph_latch_);
+      if (dependency_graph_.HasCycle()) {
+        auto cycle = dependency_graph_.DetectCycle(transaction_id);
+        victim = SelectDeadlockVictim(cycle);
+      }
+    }
+    if (victim) {
+      RecoverFromDeadlock(lock, *victim);
+      RunCompletions(lock);
+    }
+  }
+
+  /**
+   * @brief Periodically search the entire dependency graph for deadlocks and
+   * recover from all of them. The method is executed by the background
+   * deadlock detector thread when the `DetectInBackgroundPolicy` is used.
+   *
+   */
+  void DetectDeadlocks() {
+    UniqueLock lock(detector_latch_);
+    while (!detector_cv_.WaitFor(lock, timeout_,
+                                 [this]() { return detector_stopped_; })) {
+      lock.unlock();
+      // Keep recovering till no more deadlocks exist. Each recovery removes the
+      // dependencies of the denied request thus breaking the discovered cycle.
+      while (true) {
+        std::optional<WaitingTransaction> victim;
+        {
+          LockGuard graph_guard(graph_latch_);
+          if (dependency_graph_.HasCycle()) {
+            auto cycle = dependency_graph_.DetectCycle();
+            victim = SelectDeadlockVictim(cycle);
+          }
+        }
+        if (!victim) {
+          break;
+        }
+
+        auto& shard = GetShard(victim->second);
+        LockGuard guard(shard.latch);
+        auto table_it = shard.table.find(victim->second);
+        if (table_it == shard.table.end() ||
+            !DenyLockRequest(table_it->second, victim->second,
+                             victim->first)) {
+          // The state of the selected request changed since the discovery.
+          // Retry in the next detection round.
+          break;
+        }
+      }
+      RunCompletions();
+      lock.lock();
+    }
+  }
+
+  /**
+   * @brief Select the transaction from the given cycle of dependent
+   * transactions whose waiting request is to be denied for recovery.
+   *
+   * @note The caller should hold the graph latch.
+   *
+   * @param cycle Constant reference to the view of transaction identifiers
+   * forming a cycle in the dependency graph. Empty if no deadlock exists.
+   * @returns The selected transaction identifier along with the identifier of
+   * the record on which it is waiting, or null if no deadlock exists.
+   */
+  std::optional<WaitingTransaction> SelectDeadlockVictim(
+      const typename DependencyGraph::CycleView& cycle) {
+    // Only the transactions in the cycle are candidates for the victim. They
+    // are collected into a reused buffer to avoid allocation.
+    cycle_transactions_.clear();
+    for (auto it = cycle.begin(); it != cycle.end(); ++it) {
+      if (auto transaction_id = std::get_if<TransactionId>(&*it)) {
+        cycle_transactions_.push_back(*transaction_id);
+      }
+    }
+    if (!cycle_transactions_.empty()) {
+      // Instantiates selection policy for deadlock recovery
+      SelectionPolicy policy;
+      auto _transaction_id = policy(cycle_transactions_);
+      auto wait_it = wait_map_.find(_transaction_id);
+      if (wait_it != wait_map_.end()) {
+        return WaitingTransaction(_transaction_id, wait_it->second);
+      }
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Recover from a deadlock by denying the waiting request of the given
+   * victim transaction.
+   *
+   * The method is invoked with the latch of the shard containing the record of
+   * the calling transaction held. If the victim is waiting on a record
+   * belonging to another shard, the latch is temporarily released while the
+   * request is denied. This ensures that at most one shard latch is held at any
+   * time, avoiding latch ordering issues between shards.
+   *
+   * @param lock Reference to the lock holding the latch of the shard
+   * containing the record of the calling transaction.
+   * @param victim Constant reference to the victim transaction identifier
+   * along with the identifier of the record on which it is waiting.
+   * @returns `true` if the request of the victim is denied, `false` if it
+   * stopped waiting meanwhile.
+   */
+  bool RecoverFromDeadlock(UniqueLock& lock, const WaitingTransaction& victim) {
+    auto& _shard = GetShard(victim.second);
+    bool same_shard = lock.mutex() == &_shard.latch;
+    if (!same_shard) {
+      lock.unlock();
+      _shard.latch.lock();
+    }
+
+    // The state of the selected request might have changed if the latch was
+    // released. The request is denied only if it is still waiting.
+    auto table_it = _shard.table.find(victim.second);
+    bool denied =
+        table_it != _shard.table.end() &&
+        DenyLockRequest(table_it->second, victim.second, victim.first);
+
+    if (!same_shard) {
+      _shard.latch.unlock();
+      lock.lock();
+    }
+    return denied;
+  }
+
+  /**
+   * @brief Recover from all the deadlocks in the dependency graph, searching
+   * the entire graph since a cycle might not pass through the calling
+   * transaction by the time it is searched for. Recovery stops once no cycle
+   * is left, no victim is found in a cycle, or the request of a victim stopped
+   * waiting while the latch was released, leaving any remaining deadlock to
+   * the periodic checks of the waiting transactions.
+   *
+   * @param lock Reference to the lock holding the latch of the shard
+   * containing the record of the calling transaction.
+   */
+  void RecoverFromDeadlocks(UniqueLock& lock) {
+    while (true) {
+      std::optional<WaitingTransaction> victim;
+      {
+        LockGuard graph_guard(graph_latch_);
+        if (dependency_graph_.HasCycle()) {
+          victim = SelectDeadlockVictim(dependency_graph_.DetectCycle());
+        }
+      }
+      if (!victim || !RecoverFromDeadlock(lock, *victim)) {
+        return;
+      }
     }
   }
 
-  // Lock mode contention matrix
-  const ContentionMatrix<modes_count> contention_matrix_;
+  // Lock mode contention table
+  const details::ContentionTable<modes_count> contention_table_;
+  // Lock mode conversion table
+  const details::ConversionTable<modes_count> conversion_table_;
   // transaction wait timeout to check for deadlocks.
   static constexpr std::chrono::milliseconds timeout_{timeout};
-  // Latch for atomic modification of the lock.
-  std::mutex latch_;
-  // Lock table recording state of the lock.
-  LockTable table_;
+  // Partitions of the lock table recording state of the lock.
+  std::array<LockTableShard, shards_count> shards_;
+  // Latch for atomic modification of the wait map, the dependency graph and the
+  // wounded transactions.
+  // The latch is always acquired after the shard latch, if any, is held.
+  std::mutex graph_latch_;
   // Maps waiting transactions to record identifiers
   WaitMap wait_map_;
   // Dependency graph between different lock requests.
-  details::DependencyGraph<TransactionId> dependency_graph_;
+  DependencyGraph dependency_graph_;
+  // Transactions in the last discovered cycle
+  std::vector<TransactionId> cycle_transactions_;
+  // Wounded transactions yet to be aborted, used by the wound-wait policy
+  std::unordered_set<TransactionId> wounded_;
+  // Number of wounded transactions, read without the graph latch so that lock
+  // requests and unlocks skip the latch while no transaction is wounded.
+  std::atomic<size_t> wounds_count_{0};
+  // Latch for atomic modification of the completions.
+  // The latch is always acquired last, after any other latch.
+  std::mutex completion_latch_;
+  // Completed asynchronous lock requests whose callbacks are yet to be run.
+  std::vector<Completion> completions_;
+  // Latch for synchronizing with the background deadlock detector.
+  std::mutex detector_latch_;
+  // Condition variable used to stop the background deadlock detector.
+  details::ConditionVariable detector_cv_;
+  // Flag indicating if the background deadlock detector should stop.
+  bool detector_stopped_;
+  // Background deadlock detector thread.
+  std::thread detector_;
 };
 
 }  // namespace gl
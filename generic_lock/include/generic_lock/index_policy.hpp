@@ -0,0 +1,44 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__INDEX_POLICY_HPP
+#define GENERIC_LOCK__INDEX_POLICY_HPP
+
+namespace gl {
+
+/**
+ * @brief This policy keeps no index of the records locked by each transaction.
+ * Lock and unlock requests thus do no bookkeeping beyond the lock table, while
+ * releasing all the locks of a transaction scans the lock table of every shard
+ * with its latch held, as does clearing the wound of a transaction under the
+ * wound-wait policy. Only suited to small lock tables, or to transactions
+ * which never release all their locks at once.
+ *
+ */
+struct NoIndexPolicy {};
+
+/**
+ * @brief This policy indexes the records on which each transaction holds or
+ * waits for a lock, per shard. Releasing all the locks of a transaction then
+ * only visits the records it has locked, at the cost of updating the index on
+ * each lock and unlock request. This is the default policy, as the cost of
+ * releasing the locks stays proportional to the number of locks rather than
+ * to the size of the lock table.
+ *
+ */
+struct TransactionIndexPolicy {};
+
+}  // namespace gl
+
+#endif /* GENERIC_LOCK__INDEX_POLICY_HPP */
@@ -0,0 +1,199 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__LOCK_AWAITABLE_HPP
+#define GENERIC_LOCK__LOCK_AWAITABLE_HPP
+
+// The awaitables require C++20 coroutine support. Nothing is defined when
+// compiling with an earlier standard.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <generic_lock/generic_lock.hpp>
+#include <atomic>
+#include <coroutine>
+#include <utility>
+
+namespace gl {
+
+/**
+ * @brief Executor resuming an awaiting coroutine right away on the thread
+ * completing its lock request, i.e. the thread granting or denying it.
+ *
+ */
+struct InlineExecutor {
+  void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+/**
+ * @brief Lock awaitable acquires a lock on a record of a generic mutex from a
+ * coroutine without blocking the calling thread. The coroutine is suspended
+ * only if the lock request has to wait, and resumed once the request is
+ * granted or denied. The result of the `co_await` expression is `true` if the
+ * lock is acquired, otherwise `false`.
+ *
+ * @example
+ * bool granted = co_await gl::LockAwaitable(mutex, record_id, transaction_id,
+ *                                           LockMode::READ);
+ *
+ * @tparam GenericMutex The type of generic mutex.
+ * @tparam Executor The type of executor used to resume the coroutine. The
+ * executor is invoked with the handle of the suspended coroutine on the thread
+ * completing the request, once the latches of the mutex are released. It
+ * should be copyable, since a copy is invoked so that the awaitable can be
+ * destroyed along with the resumed coroutine. Default set to `InlineExecutor`.
+ */
+template <class GenericMutex, class Executor = InlineExecutor>
+class LockAwaitable {
+  typedef typename GenericMutex::record_id_t record_id_t;
+  typedef typename GenericMutex::lock_mode_t lock_mode_t;
+  typedef typename GenericMutex::transaction_id_t transaction_id_t;
+
+ public:
+  /**
+   * @brief Construct a new Lock Awaitable object.
+   *
+   * @param generic_mutex Reference to the generic mutex to lock.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param executor The executor used to resume the coroutine.
+   */
+  LockAwaitable(GenericMutex& generic_mutex, const record_id_t& record_id,
+                const transaction_id_t& transaction_id, const lock_mode_t& mode,
+                Executor executor = Executor())
+      : generic_mutex_ptr_(&generic_mutex),
+        record_id_(record_id),
+        transaction_id_(transaction_id),
+        mode_(mode),
+        executor_(std::move(executor)),
+        granted_(false),
+        completed_(false) {}
+
+  // Awaitable not copyable
+  LockAwaitable(const LockAwaitable& other) = delete;
+  // Awaitable not copy assignable
+  LockAwaitable& operator=(const LockAwaitable& other) = delete;
+
+  /**
+   * @brief The lock request is always made, so the coroutine is never resumed
+   * right away.
+   *
+   * @returns `false`
+   */
+  bool await_ready() const noexcept { return false; }
+
+  /**
+   * @brief Make the lock request, suspending the coroutine if the request has
+   * to wait. The request completes either during the call, in which case the
+   * coroutine is not suspended, or later on the thread granting or denying
+   * it. Whichever of the two finishes last resumes the coroutine.
+   *
+   * @param handle Handle of the awaiting coroutine.
+   * @returns `true` if the coroutine stays suspended else `false`.
+   */
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    generic_mutex_ptr_->LockAsync(record_id_, transaction_id_, mode_,
+                                  [this](bool granted) {
+                                    granted_ = granted;
+                                    // The coroutine frame holding the
+                                    // awaitable may be destroyed as soon as
+                                    // the coroutine is resumed, so the
+                                    // executor and handle are copied first.
+                                    auto executor = executor_;
+                                    auto handle = handle_;
+                                    if (completed_.exchange(true)) {
+                                      executor(handle);
+                                    }
+                                  });
+    return !completed_.exchange(true);
+  }
+
+  /**
+   * @brief Get the outcome of the lock request.
+   *
+   * @returns `true` if the lock is acquired else `false`.
+   */
+  bool await_resume() const noexcept { return granted_; }
+
+ protected:
+  GenericMutex* generic_mutex_ptr_;
+  record_id_t record_id_;
+  transaction_id_t transaction_id_;
+  lock_mode_t mode_;
+  Executor executor_;
+  std::coroutine_handle<> handle_;
+  bool granted_;
+  // Flag set by the first of the lock request completing and the coroutine
+  // finishing its suspension.
+  std::atomic<bool> completed_;
+};
+
+/**
+ * @brief Generic lock awaitable acquires a lock on a record of a generic mutex
+ * from a coroutine just like the lock awaitable, but the result of the
+ * `co_await` expression is a generic lock managing the acquired lock. The
+ * returned generic lock owns the mutex if the request is granted, and is
+ * denied otherwise.
+ *
+ * @example
+ * auto lock = co_await gl::GenericLockAwaitable(
+ *     mutex, record_id, transaction_id, LockMode::READ);
+ *
+ * @tparam GenericMutex The type of generic mutex.
+ * @tparam Executor The type of executor used to resume the coroutine. Default
+ * set to `InlineExecutor`.
+ */
+template <class GenericMutex, class Executor = InlineExecutor>
+class GenericLockAwaitable : public LockAwaitable<GenericMutex, Executor> {
+  typedef typename GenericMutex::record_id_t record_id_t;
+  typedef typename GenericMutex::lock_mode_t lock_mode_t;
+  typedef typename GenericMutex::transaction_id_t transaction_id_t;
+
+ public:
+  /**
+   * @brief Construct a new Generic Lock Awaitable object.
+   *
+   * @param generic_mutex Reference to the generic mutex to lock.
+   * @param record_id Constant reference to the record identifier.
+   * @param transaction_id Constant reference to the transaction identifier.
+   * @param mode Constant reference to the lock mode.
+   * @param executor The executor used to resume the coroutine.
+   */
+  GenericLockAwaitable(GenericMutex& generic_mutex,
+                       const record_id_t& record_id,
+                       const transaction_id_t& transaction_id,
+                       const lock_mode_t& mode, Executor executor = Executor())
+      : LockAwaitable<GenericMutex, Executor>(generic_mutex, record_id,
+                                              transaction_id, mode,
+                                              std::move(executor)) {}
+
+  /**
+   * @brief Get the generic lock managing the outcome of the lock request.
+   *
+   * @returns Generic lock owning the mutex if the request is granted, or a
+   * denied generic lock otherwise.
+   */
+  GenericLock<GenericMutex> await_resume() const {
+    return GenericLock<GenericMutex>(*this->generic_mutex_ptr_,
+                                     this->record_id_, this->transaction_id_,
+                                     this->mode_, this->granted_);
+  }
+};
+
+}  // namespace gl
+
+#endif
+
+#endif /* GENERIC_LOCK__LOCK_AWAITABLE_HPP */
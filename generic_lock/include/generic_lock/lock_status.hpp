@@ -0,0 +1,31 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GENERIC_LOCK__LOCK_STATUS_HPP
+#define GENERIC_LOCK__LOCK_STATUS_HPP
+
+namespace gl {
+
+/**
+ * @brief Outcome of a lock request made with a deadline. The request is either
+ * granted, denied due to deadlock discovery or prevention, or it timed out
+ * before it could be granted or denied. A request which timed out leaves no
+ * trace behind in the mutex.
+ *
+ */
+enum class LockStatus { GRANTED, DENIED, TIMEOUT };
+
+}  // namespace gl
+
+#endif /* GENERIC_LOCK__LOCK_STATUS_HPP */
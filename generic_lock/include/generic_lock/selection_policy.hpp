@@ -35,9 +35,13 @@ class SelectMaxPolicy {
    * @brief The method invokes the policy by selecting the identifier with max
    * value from the given set.
    *
-   * @param transaction_ids Reference to the set of transaction identifiers.
+   * @tparam Container The type of the container of transaction identifiers,
+   * e.g. `std::set` or the cycle view of the dependency graph.
+   * @param transaction_ids Constant reference to the set of transaction
+   * identifiers.
    */
-  TransactionId operator()(std::set<TransactionId>& transaction_ids) {
+  template <class Container>
+  TransactionId operator()(const Container& transaction_ids) {
     auto _it = transaction_ids.begin();
     for (auto it = transaction_ids.begin(); it != transaction_ids.end(); ++it) {
       if (*_it < *it) {
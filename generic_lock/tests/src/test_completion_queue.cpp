@@ -0,0 +1,95 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Unit Test Completion Queue
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <generic_lock/completion_queue.hpp>
+#include <generic_lock/generic_mutex.hpp>
+
+// The completion queue is only available on Linux.
+#if __has_include(<sys/eventfd.h>)
+
+#include <poll.h>
+
+using namespace gl;
+
+class CompletionQueueTestFixture : public ::testing::Test {
+ protected:
+  typedef size_t RecordId;
+  typedef size_t TransactionId;
+
+  // ----------------------------
+  enum class LockMode { READ, WRITE };
+  const ContentionMatrix<2> contention_matrix = {
+      {{{false, true}}, {{true, true}}}};
+
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, 1>
+      GenericMutexType;
+  GenericMutexType mutex = {contention_matrix};
+  CompletionQueue<GenericMutexType> queue{mutex};
+  // ----------------------------
+
+  // Check if the eventfd of the queue is readable.
+  bool Readable() {
+    pollfd fd = {queue.FileDescriptor(), POLLIN, 0};
+    return poll(&fd, 1, 0) == 1;
+  }
+};
+
+TEST_F(CompletionQueueTestFixture, TestPoll) {
+  ASSERT_FALSE(Readable());
+  ASSERT_TRUE(queue.Poll().empty());
+
+  // Requests granted right away are completed during submission.
+  queue.Lock(0, 1, LockMode::WRITE);
+  queue.Lock(1, 2, LockMode::WRITE);
+  ASSERT_TRUE(Readable());
+  auto completions = queue.Poll();
+  ASSERT_EQ(completions.size(), 2);
+  ASSERT_EQ(completions[0].record_id, 0);
+  ASSERT_EQ(completions[0].transaction_id, 1);
+  ASSERT_EQ(completions[0].mode, LockMode::WRITE);
+  ASSERT_TRUE(completions[0].granted);
+  ASSERT_EQ(completions[1].transaction_id, 2);
+  ASSERT_TRUE(completions[1].granted);
+  ASSERT_FALSE(Readable());
+
+  // Waiting requests are completed when granted or denied.
+  queue.Lock(1, 1, LockMode::READ);
+  ASSERT_FALSE(Readable());
+  queue.Lock(0, 2, LockMode::READ);
+  ASSERT_TRUE(Readable());
+  completions = queue.Poll();
+  ASSERT_EQ(completions.size(), 1);
+  ASSERT_EQ(completions[0].transaction_id, 2);
+  ASSERT_FALSE(completions[0].granted);
+  mutex.Unlock(1, 2);
+  ASSERT_TRUE(Readable());
+  completions = queue.Poll();
+  ASSERT_EQ(completions.size(), 1);
+  ASSERT_EQ(completions[0].record_id, 1);
+  ASSERT_EQ(completions[0].transaction_id, 1);
+  ASSERT_TRUE(completions[0].granted);
+  ASSERT_FALSE(Readable());
+
+  mutex.Unlock(0, 1);
+  mutex.Unlock(1, 1);
+}
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -43,6 +44,18 @@ class ConditionVariableTestFixture : public ::testing::Test {
       return queue.back();
     }
 
+    std::optional<T> GetUntil(
+        const std::chrono::steady_clock::time_point& deadline) const {
+      std::unique_lock<std::mutex> lock(_mutex);
+
+      if (!_cv.WaitUntil(
+              lock, deadline, timeout, [&]() { callback_called = true; },
+              [&]() { return !queue.empty(); })) {
+        return std::nullopt;
+      }
+      return queue.back();
+    }
+
     void Put(const T& value) {
       std::unique_lock<std::mutex> lock(_mutex);
 
@@ -89,3 +102,29 @@ TEST_F(ConditionVariableTestFixture, TestWait) {
   ASSERT_EQ(value, 10);
   ASSERT_TRUE(queue.callback_called);
 }
+
+TEST_F(ConditionVariableTestFixture, TestWaitUntil) {
+  std::thread thread_a, thread_b;
+  std::optional<int> value;
+
+  // Deadline reached before any value is put
+  value = queue.GetUntil(std::chrono::steady_clock::now() + 4 * queue.timeout);
+  ASSERT_FALSE(value);
+  ASSERT_TRUE(queue.callback_called);
+
+  // Start threads
+  thread_a = std::thread([&]() {
+    std::this_thread::sleep_for(2 * queue.timeout);
+    queue.Put(10);
+  });
+  thread_b = std::thread([&]() {
+    value =
+        queue.GetUntil(std::chrono::steady_clock::now() + 100 * queue.timeout);
+  });
+
+  // Wait till all threads to finish
+  thread_a.join();
+  thread_b.join();
+
+  ASSERT_EQ(value, 10);
+}
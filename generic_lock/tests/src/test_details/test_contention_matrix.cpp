@@ -0,0 +1,78 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Uint Test Contention Matrix
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <generic_lock/contention_policy.hpp>
+
+using namespace gl;
+using namespace gl::details;
+
+TEST(ContentionTableTestFixture, TestContends) {
+  enum class LockMode { IS, IX, S, SIX, X };
+  constexpr ContentionTable<5> table(multigranularity_contention_matrix);
+  constexpr auto intention_modes =
+      table.Mask(LockMode::IS) | table.Mask(LockMode::IX);
+
+  static_assert(!table.Contends(intention_modes, LockMode::IX));
+  ASSERT_FALSE(table.Contends(0, LockMode::X));
+  ASSERT_FALSE(table.Contends(intention_modes, LockMode::IS));
+  ASSERT_TRUE(table.Contends(intention_modes, LockMode::S));
+  ASSERT_TRUE(table.Contends(table.Mask(LockMode::IS), LockMode::X));
+  ASSERT_FALSE(table.Contends(table.Mask(LockMode::S), LockMode::IS));
+  ASSERT_TRUE(table.Contends(table.Mask(LockMode::SIX), LockMode::IX));
+}
+
+TEST(ContentionTableTestFixture, TestAsymmetricContention) {
+  enum class LockMode { A, B };
+  // Mode `B` requested contends with mode `A` held, but not the other way.
+  const ContentionMatrix<2> contention_matrix = {
+      {{{false, true}}, {{false, false}}}};
+  ContentionTable<2> table(contention_matrix);
+
+  ASSERT_TRUE(table.Contends(table.Mask(LockMode::A), LockMode::B));
+  ASSERT_FALSE(table.Contends(table.Mask(LockMode::B), LockMode::A));
+}
+
+TEST(ConversionTableTestFixture, TestSupremum) {
+  enum class LockMode { IS, IX, S, SIX, X };
+  constexpr ConversionTable<5> table(multigranularity_contention_matrix);
+
+  static_assert(table.Supremum(LockMode::S, LockMode::IX) ==
+                size_t(LockMode::SIX));
+  ASSERT_EQ(table.Supremum(LockMode::IX, LockMode::S), size_t(LockMode::SIX));
+  ASSERT_EQ(table.Supremum(LockMode::IS, LockMode::IX), size_t(LockMode::IX));
+  ASSERT_EQ(table.Supremum(LockMode::IS, LockMode::S), size_t(LockMode::S));
+  ASSERT_EQ(table.Supremum(LockMode::S, LockMode::S), size_t(LockMode::S));
+  ASSERT_EQ(table.Supremum(LockMode::SIX, LockMode::IS),
+            size_t(LockMode::SIX));
+  ASSERT_EQ(table.Supremum(LockMode::S, LockMode::X), size_t(LockMode::X));
+}
+
+TEST(ConversionTableTestFixture, TestNoSupremum) {
+  enum class LockMode { A, B };
+  // Each mode contends only with itself so no mode covers both.
+  const ContentionMatrix<2> contention_matrix = {
+      {{{true, false}}, {{false, true}}}};
+  ConversionTable<2> table(contention_matrix);
+
+  ASSERT_EQ(table.Supremum(LockMode::A, LockMode::A), size_t(LockMode::A));
+  ASSERT_EQ(table.Supremum(LockMode::A, LockMode::B),
+            ConversionTable<2>::null_mode);
+}
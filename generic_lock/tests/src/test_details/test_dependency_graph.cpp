@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include <generic_lock/details/dependency_graph.hpp>
+#include <set>
 
 using namespace gl::details;
 
@@ -27,6 +28,12 @@ class DependencyGraphTestFixture : public ::testing::Test {
  protected:
   DependencyGraph<size_t> graph;
 
+  template <class... Args>
+  std::set<size_t> DetectCycle(Args... args) {
+    auto cycle = graph.DetectCycle(args...);
+    return {cycle.begin(), cycle.end()};
+  }
+
   void SetUp() override {}
   void TearDown() override {}
 };
@@ -66,17 +73,17 @@ TEST_F(DependencyGraphTestFixture, TestDetectCycleExists) {
   graph.Add(8, 9);
   graph.Add(8, 10);
 
-  _cycle = graph.DetectCycle(4);
+  _cycle = DetectCycle(4);
   ASSERT_TRUE(_cycle.empty());
-  _cycle = graph.DetectCycle(1);
+  _cycle = DetectCycle(1);
   ASSERT_EQ(_cycle, cycle);
-  _cycle = graph.DetectCycle(2);
+  _cycle = DetectCycle(2);
   ASSERT_EQ(_cycle, cycle);
-  _cycle = graph.DetectCycle(5);
+  _cycle = DetectCycle(5);
   ASSERT_EQ(_cycle, cycle);
-  _cycle = graph.DetectCycle(6);
+  _cycle = DetectCycle(6);
   ASSERT_EQ(_cycle, cycle);
-  _cycle = graph.DetectCycle(7);
+  _cycle = DetectCycle(7);
   ASSERT_EQ(_cycle, cycle);
 }
 
@@ -94,4 +101,65 @@ TEST_F(DependencyGraphTestFixture, TestDetectNoCycle) {
 
   auto cycle = graph.DetectCycle(1);
   ASSERT_TRUE(cycle.empty());
-}
\ No newline at end of file
+}
+
+TEST_F(DependencyGraphTestFixture, TestDetectCycleInLongChain) {
+  // Chain long enough to overflow the stack if transversed recursively
+  const size_t length = 1000000;
+  for (size_t i = 0; i < length; ++i) {
+    graph.Add(i, i + 1);
+  }
+  ASSERT_TRUE(graph.DetectCycle(0).empty());
+
+  graph.Add(length, 0);
+  auto cycle = graph.DetectCycle(0);
+  ASSERT_EQ(cycle.size(), length + 1);
+  ASSERT_EQ(DetectCycle(), DetectCycle(length));
+}
+
+TEST_F(DependencyGraphTestFixture, TestDetectAnyCycle) {
+  std::set<size_t> cycle = {5, 6, 7};
+
+  graph.Add(1, 2);
+  graph.Add(2, 3);
+  graph.Add(4, 5);
+  graph.Add(5, 6);
+  graph.Add(6, 7);
+  graph.Add(7, 5);
+  ASSERT_EQ(DetectCycle(), cycle);
+
+  graph.Remove(7, 5);
+  ASSERT_TRUE(graph.DetectCycle().empty());
+}
+
+TEST_F(DependencyGraphTestFixture, TestIncrementalCycleDetection) {
+  ASSERT_FALSE(graph.Add(1, 2));
+  ASSERT_FALSE(graph.Add(3, 4));
+  ASSERT_FALSE(graph.Add(4, 1));
+  ASSERT_FALSE(graph.Add(2, 5));
+  ASSERT_FALSE(graph.HasCycle());
+
+  // Dependency closing the cycle 1 -> 2 -> 5 -> 3 -> 4 -> 1
+  ASSERT_TRUE(graph.Add(5, 3));
+  ASSERT_TRUE(graph.HasCycle());
+
+  // Dependency against the order not closing any cycle
+  ASSERT_FALSE(graph.Add(2, 6));
+  ASSERT_FALSE(graph.Add(6, 7));
+  ASSERT_FALSE(graph.Add(8, 9));
+  ASSERT_FALSE(graph.Add(9, 6));
+  ASSERT_TRUE(graph.HasCycle());
+
+  // Breaking the cycle orders the dependency closing it
+  graph.Remove(4, 1);
+  ASSERT_FALSE(graph.HasCycle());
+  ASSERT_TRUE(graph.IsDependent(5, 3));
+  ASSERT_TRUE(graph.Add(4, 2));
+  ASSERT_TRUE(graph.HasCycle());
+
+  // Removing a node breaks all the cycles through it
+  graph.Remove(3);
+  ASSERT_FALSE(graph.HasCycle());
+  ASSERT_FALSE(graph.Add(4, 2));
+  ASSERT_TRUE(graph.DetectCycle().empty());
+}
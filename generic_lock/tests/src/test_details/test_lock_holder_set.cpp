@@ -0,0 +1,92 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Uint Test Lock Holder Set
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <generic_lock/details/lock_holder_set.hpp>
+
+using namespace gl::details;
+
+class LockHolderSetTestFixture : public ::testing::Test {
+ protected:
+  enum class LockMode { READ, WRITE };
+  const ContentionTable<2> contention_table = {
+      {{{{false, true}}, {{true, true}}}}};
+  LockHolderSet<size_t, LockMode, 2, 2> holders;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(LockHolderSetTestFixture, TestEmplaceHolder) {
+  ASSERT_TRUE(holders.EmplaceHolder(1, LockMode::READ, contention_table));
+  // Duplicate holder
+  ASSERT_FALSE(holders.EmplaceHolder(1, LockMode::READ, contention_table));
+  // Contending holder
+  ASSERT_FALSE(holders.EmplaceHolder(2, LockMode::WRITE, contention_table));
+  ASSERT_TRUE(holders.EmplaceHolder(2, LockMode::READ, contention_table));
+  // Full set
+  ASSERT_FALSE(holders.EmplaceHolder(3, LockMode::READ, contention_table));
+  ASSERT_EQ(holders.Size(), 2);
+}
+
+TEST_F(LockHolderSetTestFixture, TestRemoveHolder) {
+  holders.EmplaceHolder(1, LockMode::READ, contention_table);
+  ASSERT_FALSE(holders.RemoveHolder(2));
+  ASSERT_TRUE(holders.RemoveHolder(1));
+  ASSERT_TRUE(holders.Empty());
+
+  // Lock modes of the removed holders no longer contend
+  ASSERT_TRUE(holders.EmplaceHolder(2, LockMode::WRITE, contention_table));
+  ASSERT_FALSE(holders.EmplaceHolder(3, LockMode::READ, contention_table));
+  holders.Clear();
+  ASSERT_TRUE(holders.EmplaceHolder(3, LockMode::READ, contention_table));
+  ASSERT_EQ(holders.Begin()->transaction_id, 3);
+}
+
+TEST_F(LockHolderSetTestFixture, TestConvertHolder) {
+  holders.EmplaceHolder(1, LockMode::READ, contention_table);
+  ASSERT_FALSE(holders.ConvertHolder(2, LockMode::WRITE, contention_table));
+  ASSERT_TRUE(holders.ConvertHolder(1, LockMode::WRITE, contention_table));
+  ASSERT_EQ(holders.FindHolder(1)->mode, LockMode::WRITE);
+  ASSERT_FALSE(holders.EmplaceHolder(2, LockMode::READ, contention_table));
+
+  // Conversion contending with another holder
+  ASSERT_TRUE(holders.ConvertHolder(1, LockMode::READ, contention_table));
+  ASSERT_TRUE(holders.EmplaceHolder(2, LockMode::READ, contention_table));
+  ASSERT_FALSE(holders.ConvertHolder(1, LockMode::WRITE, contention_table));
+  ASSERT_EQ(holders.FindHolder(1)->mode, LockMode::READ);
+  ASSERT_EQ(holders.FindHolder(3), nullptr);
+}
+
+TEST_F(LockHolderSetTestFixture, TestHoldCount) {
+  holders.EmplaceHolder(1, LockMode::READ, contention_table);
+  ASSERT_FALSE(holders.AddHold(2));
+  ASSERT_TRUE(holders.AddHold(1));
+  ASSERT_EQ(holders.FindHolder(1)->hold_count, 2);
+
+  // The holder is removed once each acquisition is released
+  ASSERT_FALSE(holders.ReleaseHold(1));
+  ASSERT_EQ(holders.FindHolder(1)->hold_count, 1);
+  ASSERT_FALSE(holders.EmplaceHolder(2, LockMode::WRITE, contention_table));
+  ASSERT_TRUE(holders.ReleaseHold(1));
+  ASSERT_TRUE(holders.Empty());
+  ASSERT_FALSE(holders.ReleaseHold(1));
+  ASSERT_TRUE(holders.EmplaceHolder(2, LockMode::WRITE, contention_table));
+}
@@ -44,4 +44,13 @@ TEST_F(LockRequestTestFixture, ApproveDenyRequest) {
   ASSERT_TRUE(request.IsDenied());
   request.Approve();
   ASSERT_FALSE(request.IsDenied());
-}
\ No newline at end of file
+}
+
+TEST_F(LockRequestTestFixture, HoldCount) {
+  ASSERT_EQ(request.GetHoldCount(), 1);
+  request.AddHold();
+  ASSERT_EQ(request.GetHoldCount(), 2);
+  ASSERT_EQ(request.ReleaseHold(), 1);
+  request.SetHoldCount(3);
+  ASSERT_EQ(request.GetHoldCount(), 3);
+}
@@ -74,4 +74,48 @@ TEST_F(LockRequestGroupTestFixture, EmplaceRemoveRequest) {
   group.RemoveLockRequest(2);
   ASSERT_EQ(group.Size(), 0);
   ASSERT_TRUE(group.Empty());
-}
\ No newline at end of file
+}
+
+TEST_F(LockRequestGroupTestFixture, DenyRemoveRequestContention) {
+  ASSERT_TRUE(group.EmplaceLockRequest(1, LockMode::READ, contention_matrix));
+  ASSERT_TRUE(group.EmplaceLockRequest(2, LockMode::READ, contention_matrix));
+  ASSERT_FALSE(group.EmplaceLockRequest(3, LockMode::WRITE, contention_matrix));
+
+  // Denied request no longer contends with new requests
+  group.DenyLockRequest(1);
+  ASSERT_TRUE(group.GetLockRequest(1).IsDenied());
+  ASSERT_FALSE(group.EmplaceLockRequest(3, LockMode::WRITE, contention_matrix));
+  group.RemoveLockRequest(2);
+  ASSERT_TRUE(group.EmplaceLockRequest(3, LockMode::WRITE, contention_matrix));
+
+  // Removing the denied request keeps the write request contending
+  group.RemoveLockRequest(1);
+  ASSERT_FALSE(group.EmplaceLockRequest(4, LockMode::READ, contention_matrix));
+  group.RemoveLockRequest(3);
+  ASSERT_TRUE(group.EmplaceLockRequest(4, LockMode::READ, contention_matrix));
+}
+
+TEST_F(LockRequestGroupTestFixture, ConvertRequest) {
+  group.EmplaceLockRequest(1, LockMode::READ, contention_matrix);
+  // Sole request is converted in place
+  ASSERT_TRUE(group.ConvertLockRequest(1, LockMode::WRITE, contention_matrix));
+  ASSERT_EQ(group.GetLockRequest(1).GetMode(), LockMode::WRITE);
+  ASSERT_TRUE(group.ConvertLockRequest(1, LockMode::READ, contention_matrix));
+
+  // Conversion contending with another request stays pending
+  group.EmplaceLockRequest(2, LockMode::READ, contention_matrix);
+  ASSERT_FALSE(group.ConvertLockRequest(1, LockMode::WRITE, contention_matrix));
+  group.BeginConversion(1, LockMode::WRITE);
+  ASSERT_TRUE(group.HasConversions());
+  ASSERT_TRUE(group.GetLockRequest(1).IsConverting());
+  ASSERT_EQ(group.GetLockRequest(1).GetMode(), LockMode::READ);
+
+  // No request joins the group while a conversion is pending
+  ASSERT_FALSE(group.EmplaceLockRequest(3, LockMode::READ, contention_matrix));
+
+  group.RemoveLockRequest(2);
+  ASSERT_TRUE(group.ConvertLockRequest(1, LockMode::WRITE, contention_matrix));
+  ASSERT_FALSE(group.HasConversions());
+  ASSERT_FALSE(group.GetLockRequest(1).IsConverting());
+  ASSERT_FALSE(group.EmplaceLockRequest(3, LockMode::READ, contention_matrix));
+}
@@ -61,7 +61,7 @@ TEST_F(LockRequestQueueTestFixture, TestEmplaceGetRequest) {
   ASSERT_EQ(request.GetMode(), LockMode::READ);
   ASSERT_FALSE(request.IsDenied());
 
-  queue.GetLockRequest(1).Deny();
+  queue.DenyLockRequest(1);
   ASSERT_TRUE(request.IsDenied());
 }
 
@@ -87,3 +87,39 @@ TEST_F(LockRequestQueueTestFixture, TestEmplaceRemoveGetRequest) {
   ASSERT_THROW(queue.GetLockRequest(1), std::out_of_range);
   ASSERT_EQ(queue.Size(), 0);
 }
+
+TEST_F(LockRequestQueueTestFixture, TestFindGroup) {
+  auto group_id_1 =
+      queue.EmplaceLockRequest(1, LockMode::READ, contention_matrix);
+  auto group_id_2 =
+      queue.EmplaceLockRequest(2, LockMode::WRITE, contention_matrix);
+
+  auto group_it = queue.FindGroup(group_id_2);
+  ASSERT_NE(group_it, queue.End());
+  ASSERT_EQ(group_it->key, group_id_2);
+  ASSERT_EQ(std::prev(group_it), queue.FindGroup(group_id_1));
+  ASSERT_EQ(queue.FindGroup(group_id_2 + 1), queue.End());
+}
+
+TEST_F(LockRequestQueueTestFixture, TestPromoteRequest) {
+  auto front_group_id = queue.EmplaceLockRequest(1, LockMode::WRITE,
+                                                 contention_matrix);
+  auto group_id =
+      queue.EmplaceLockRequest(2, LockMode::READ, contention_matrix);
+  queue.EmplaceLockRequest(3, LockMode::READ, contention_matrix);
+
+  // Requests contending with the front group are not moved
+  ASSERT_FALSE(queue.PromoteLockRequest(2, contention_matrix));
+  ASSERT_FALSE(queue.PromoteLockRequest(1, contention_matrix));
+
+  queue.FindGroup(front_group_id)
+      ->value.ConvertLockRequest(1, LockMode::READ, contention_matrix);
+  ASSERT_TRUE(queue.PromoteLockRequest(2, contention_matrix));
+  ASSERT_EQ(queue.GetGroupId(2), front_group_id);
+  ASSERT_NE(queue.FindGroup(group_id), queue.End());
+
+  // The group left empty is removed
+  ASSERT_TRUE(queue.PromoteLockRequest(3, contention_matrix));
+  ASSERT_EQ(queue.GetGroupId(3), front_group_id);
+  ASSERT_EQ(queue.FindGroup(group_id), queue.End());
+}
@@ -0,0 +1,103 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Uint Test Small Vector
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <generic_lock/details/small_vector.hpp>
+#include <string>
+
+using namespace gl::details;
+
+class SmallVectorTestFixture : public ::testing::Test {
+ protected:
+  SmallVector<int, 2> vector;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(SmallVectorTestFixture, TestPushBack) {
+  ASSERT_TRUE(vector.Empty());
+
+  vector.PushBack(1);
+  vector.PushBack(2);
+  ASSERT_EQ(vector.Size(), 2);
+  ASSERT_TRUE(vector.IsInline());
+
+  vector.PushBack(3);
+  ASSERT_EQ(vector.Size(), 3);
+  ASSERT_FALSE(vector.IsInline());
+  ASSERT_EQ(vector[0], 1);
+  ASSERT_EQ(vector[1], 2);
+  ASSERT_EQ(vector[2], 3);
+}
+
+TEST_F(SmallVectorTestFixture, TestErase) {
+  vector.PushBack(1);
+  vector.PushBack(2);
+  vector.PushBack(3);
+
+  // The last value replaces the erased value.
+  vector.Erase(vector.Begin());
+  ASSERT_EQ(vector.Size(), 2);
+  ASSERT_EQ(vector[0], 3);
+  ASSERT_EQ(vector[1], 2);
+
+  vector.Erase(vector.Begin() + 1);
+  ASSERT_EQ(vector.Size(), 1);
+  ASSERT_EQ(vector[0], 3);
+
+  vector.Clear();
+  ASSERT_TRUE(vector.Empty());
+}
+
+TEST_F(SmallVectorTestFixture, TestMove) {
+  vector.PushBack(1);
+  SmallVector<int, 2> _vector(std::move(vector));
+  ASSERT_TRUE(vector.Empty());
+  ASSERT_EQ(_vector.Size(), 1);
+  ASSERT_TRUE(_vector.IsInline());
+
+  _vector.PushBack(2);
+  _vector.PushBack(3);
+  vector = std::move(_vector);
+  ASSERT_TRUE(_vector.Empty());
+  ASSERT_EQ(vector.Size(), 3);
+  ASSERT_EQ(vector[2], 3);
+}
+
+TEST_F(SmallVectorTestFixture, TestNonTrivialValues) {
+  SmallVector<std::string, 1> strings;
+  strings.PushBack("first");
+  strings.PushBack("second");
+  strings.PushBack("third");
+  ASSERT_FALSE(strings.IsInline());
+
+  strings.Erase(strings.Begin());
+  ASSERT_EQ(strings.Size(), 2);
+  ASSERT_EQ(strings[0], "third");
+  ASSERT_EQ(strings[1], "second");
+
+  SmallVector<std::string, 1> _strings;
+  _strings.PushBack("inline");
+  strings = std::move(_strings);
+  ASSERT_TRUE(_strings.Empty());
+  ASSERT_TRUE(strings.IsInline());
+  ASSERT_EQ(strings[0], "inline");
+}
@@ -20,6 +20,8 @@
 #include <gtest/gtest.h>
 
 #include <generic_lock/generic_lock.hpp>
+#include <chrono>
+#include <optional>
 
 using namespace gl;
 
@@ -51,6 +53,33 @@ class GenericLockTestFixture : public ::testing::Test {
       }
       return _locked;
     }
+    bool TryLock(const record_id_t& record_id,
+                 const transaction_id_t& transaction_id,
+                 const lock_mode_t& mode) {
+      if (_locked) {
+        return false;
+      }
+      return Lock(record_id, transaction_id, mode);
+    }
+    template <class Rep, class Period>
+    LockStatus TryLockFor(const record_id_t& record_id,
+                          const transaction_id_t& transaction_id,
+                          const lock_mode_t& mode,
+                          const std::chrono::duration<Rep, Period>& duration) {
+      if (_locked) {
+        return LockStatus::TIMEOUT;
+      }
+      return Lock(record_id, transaction_id, mode) ? LockStatus::GRANTED
+                                                   : LockStatus::DENIED;
+    }
+    template <class Clock, class Duration>
+    LockStatus TryLockUntil(
+        const record_id_t& record_id, const transaction_id_t& transaction_id,
+        const lock_mode_t& mode,
+        const std::chrono::time_point<Clock, Duration>& deadline) {
+      return TryLockFor(record_id, transaction_id, mode,
+                        deadline - Clock::now());
+    }
     void Unlock(const record_id_t& record_id,
                 const transaction_id_t& transaction_id) {
       if (!_locked) {
@@ -59,6 +88,33 @@ class GenericLockTestFixture : public ::testing::Test {
       }
       _locked = false;
     }
+    std::optional<lock_mode_t> Convert(const record_id_t& record_id,
+                                       const transaction_id_t& transaction_id,
+                                       const lock_mode_t& mode) {
+      if (!_locked) {
+        throw std::system_error(EPERM, std::system_category(),
+                                "MockMutex::Convert: not locked");
+      }
+      // Converts only to the write lock mode.
+      if (mode != LockMode::WRITE) {
+        return std::nullopt;
+      }
+      return mode;
+    }
+    bool Downgrade(const record_id_t& record_id,
+                   const transaction_id_t& transaction_id,
+                   const lock_mode_t& mode) {
+      if (!_locked) {
+        throw std::system_error(EPERM, std::system_category(),
+                                "MockMutex::Downgrade: not locked");
+      }
+      // Downgrades only to the read lock mode.
+      return mode == LockMode::READ;
+    }
+    bool HoldsLock(const record_id_t& record_id,
+                   const transaction_id_t& transaction_id) const {
+      return _locked;
+    }
     bool IsLocked() const { return _locked; }
 
    private:
@@ -102,6 +158,21 @@ TEST_F(GenericLockTestFixture, TestConstructorDeferredOwning) {
   ASSERT_FALSE(mutex.IsLocked());
 }
 
+TEST_F(GenericLockTestFixture, TestConstructorTryOwning) {
+  GenericLock<MockMutex> lock(mutex, record_id, transaction_id, mode,
+                              TryToLock);
+  ASSERT_TRUE(lock.OwnsLock());
+  ASSERT_FALSE(lock.IsDenied());
+  ASSERT_TRUE(mutex.IsLocked());
+
+  GenericLock<MockMutex> other_lock(mutex, record_id, 2, mode, TryToLock);
+  ASSERT_FALSE(other_lock.OwnsLock());
+  ASSERT_FALSE(other_lock.IsDenied());
+  lock.Unlock();
+  ASSERT_TRUE(other_lock.TryLock());
+  ASSERT_TRUE(other_lock.OwnsLock());
+}
+
 TEST_F(GenericLockTestFixture, TestConstructorAdoptOwning) {
   mutex.Lock(record_id, transaction_id, mode);
   GenericLock<MockMutex> lock(mutex, record_id, transaction_id, mode,
@@ -173,3 +244,55 @@ TEST_F(GenericLockTestFixture, TestAttributes) {
   ASSERT_EQ(lock.TransactionId(), transaction_id);
   ASSERT_EQ(lock.Mutex(), &mutex);
 }
+
+TEST_F(GenericLockTestFixture, TestConvert) {
+  GenericLock<MockMutex> lock(mutex, record_id, transaction_id, LockMode::READ);
+
+  ASSERT_FALSE(lock.Convert(LockMode::READ));
+  ASSERT_EQ(lock.LockMode(), LockMode::READ);
+  ASSERT_TRUE(lock.OwnsLock());
+
+  ASSERT_TRUE(lock.Convert(LockMode::WRITE));
+  ASSERT_EQ(lock.LockMode(), LockMode::WRITE);
+  ASSERT_TRUE(lock.OwnsLock());
+
+  lock.Unlock();
+  ASSERT_THROW(lock.Convert(LockMode::WRITE), std::system_error);
+}
+
+TEST_F(GenericLockTestFixture, TestDowngrade) {
+  GenericLock<MockMutex> lock(mutex, record_id, transaction_id,
+                              LockMode::WRITE);
+
+  ASSERT_FALSE(lock.Downgrade(LockMode::WRITE));
+  ASSERT_EQ(lock.LockMode(), LockMode::WRITE);
+
+  ASSERT_TRUE(lock.Downgrade(LockMode::READ));
+  ASSERT_EQ(lock.LockMode(), LockMode::READ);
+  ASSERT_TRUE(lock.OwnsLock());
+
+  lock.Unlock();
+  ASSERT_THROW(lock.Downgrade(LockMode::READ), std::system_error);
+}
+
+TEST_F(GenericLockTestFixture, TestTimedLock) {
+  GenericLock<MockMutex> lock(mutex, record_id, transaction_id, mode,
+                              DeferLock);
+  ASSERT_EQ(lock.TryLockFor(std::chrono::milliseconds(1)), LockStatus::GRANTED);
+  ASSERT_TRUE(lock.OwnsLock());
+  ASSERT_FALSE(lock.IsDenied());
+
+  GenericLock<MockMutex> other_lock(mutex, record_id, 2, mode, DeferLock);
+  ASSERT_EQ(other_lock.TryLockUntil(std::chrono::steady_clock::now()),
+            LockStatus::TIMEOUT);
+  ASSERT_FALSE(other_lock.OwnsLock());
+  ASSERT_FALSE(other_lock.IsDenied());
+
+  lock.Unlock();
+  GenericLock<MockMutex> denied_lock(mutex, 2, transaction_id, mode,
+                                     DeferLock);
+  ASSERT_EQ(denied_lock.TryLockFor(std::chrono::milliseconds(1)),
+            LockStatus::DENIED);
+  ASSERT_FALSE(denied_lock.OwnsLock());
+  ASSERT_TRUE(denied_lock.IsDenied());
+}
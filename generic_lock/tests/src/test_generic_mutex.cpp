@@ -14,9 +14,12 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <generic_lock/generic_lock.hpp>
 #include <generic_lock/generic_mutex.hpp>
@@ -26,6 +29,23 @@
 using namespace gl;
 using namespace std::chrono_literals;
 
+// Record identifier whose hashes all collide
+struct CollidingRecordId {
+  size_t id;
+
+  bool operator==(const CollidingRecordId& other) const {
+    return id == other.id;
+  }
+  bool operator<(const CollidingRecordId& other) const { return id < other.id; }
+};
+
+namespace std {
+template <>
+struct hash<CollidingRecordId> {
+  size_t operator()(const CollidingRecordId& record_id) const { return 0; }
+};
+}  // namespace std
+
 class GenericMutexTestFixture : public ::testing::Test {
  protected:
   typedef size_t RecordId;
@@ -140,6 +160,39 @@ class GenericMutexTestFixture : public ::testing::Test {
       std::this_thread::sleep_for(wait_between_operations);
     }
   }
+
+  /**
+   * @brief Run two transactions locking records `0` and `1` in opposite order
+   * on the given mutex, thus causing a deadlock.
+   *
+   * @tparam Mutex The generic mutex type.
+   * @param _mutex Reference to the generic mutex.
+   * @returns A pair of flags indicating if all the lock requests of transaction
+   * `1` and `2` respectively were granted.
+   */
+  template <class Mutex>
+  std::pair<bool, bool> CrossLockRecords(Mutex& _mutex) {
+    bool thread_1_all_granted = true;
+    bool thread_2_all_granted = true;
+
+    auto thread_1 = std::thread([&]() {
+      GenericLock<Mutex> lock_0(_mutex, 0, 1, LockMode::WRITE);
+      std::this_thread::sleep_for(wait_between_operations);
+      GenericLock<Mutex> lock_1(_mutex, 1, 1, LockMode::WRITE);
+      thread_1_all_granted = lock_0 && lock_1;
+    });
+    auto thread_2 = std::thread([&]() {
+      GenericLock<Mutex> lock_1(_mutex, 1, 2, LockMode::WRITE);
+      std::this_thread::sleep_for(wait_between_operations);
+      GenericLock<Mutex> lock_0(_mutex, 0, 2, LockMode::WRITE);
+      thread_2_all_granted = lock_1 && lock_0;
+    });
+
+    thread_1.join();
+    thread_2.join();
+
+    return {thread_1_all_granted, thread_2_all_granted};
+  }
 };
 
 TEST_F(GenericMutexTestFixture, TestLockUnlock) {
@@ -235,4 +288,868 @@ TEST_F(GenericMutexTestFixture, TestDedlockRecovery) {
       _records[op_record.record_id] = op_record.value;
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_F(GenericMutexTestFixture, TestShardedDeadlockRecovery) {
+  // Records `0` and `1` are mapped to different shards.
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 2>
+      ShardedGenericMutexType;
+  ShardedGenericMutexType sharded_mutex(contention_matrix);
+
+  // Thread 2 is denied because of the SelectMaxPolicy even though the
+  // deadlock spans records in different shards.
+  auto result = CrossLockRecords(sharded_mutex);
+  ASSERT_TRUE(result.first);
+  ASSERT_FALSE(result.second);
+}
+
+TEST_F(GenericMutexTestFixture, TestDetectOnWaitDeadlockRecovery) {
+  // Set a large timeout to assert that deadlock detection does not depend on
+  // it.
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, 60000,
+                       SelectMaxPolicy<TransactionId>, 1, DetectOnWaitPolicy>
+      EagerGenericMutexType;
+  EagerGenericMutexType eager_mutex(contention_matrix);
+
+  auto start = std::chrono::steady_clock::now();
+  auto result = CrossLockRecords(eager_mutex);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_TRUE(result.first);
+  ASSERT_FALSE(result.second);
+  ASSERT_LT(elapsed, 10s);
+}
+
+TEST_F(GenericMutexTestFixture, TestDetectInBackgroundDeadlockRecovery) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 1,
+                       DetectInBackgroundPolicy>
+      BackgroundGenericMutexType;
+  BackgroundGenericMutexType background_mutex(contention_matrix);
+
+  auto result = CrossLockRecords(background_mutex);
+  ASSERT_TRUE(result.first);
+  ASSERT_FALSE(result.second);
+}
+
+TEST_F(GenericMutexTestFixture, TestDeadlockThroughRequestGroupRecovery) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, 60000,
+                       SelectMaxPolicy<TransactionId>, 1, DetectOnWaitPolicy>
+      EagerGenericMutexType;
+  EagerGenericMutexType eager_mutex(contention_matrix);
+  typedef GenericLock<EagerGenericMutexType> EagerLockGuard;
+
+  // Transactions `1` and `3` share the read lock on record `0` for which
+  // transaction `2` waits. Transaction `3` then waits on record `1` locked by
+  // transaction `2`, thus forming a cycle through the reader group.
+  bool thread_2_all_granted = false;
+  bool thread_3_all_granted = true;
+  auto thread_1 = std::thread([&]() {
+    EagerLockGuard lock_0(eager_mutex, 0, 1, LockMode::READ);
+    std::this_thread::sleep_for(4 * wait_between_operations);
+  });
+  auto thread_2 = std::thread([&]() {
+    EagerLockGuard lock_1(eager_mutex, 1, 2, LockMode::WRITE);
+    std::this_thread::sleep_for(wait_between_operations);
+    EagerLockGuard lock_0(eager_mutex, 0, 2, LockMode::WRITE);
+    thread_2_all_granted = lock_1 && lock_0;
+  });
+  auto thread_3 = std::thread([&]() {
+    EagerLockGuard lock_0(eager_mutex, 0, 3, LockMode::READ);
+    std::this_thread::sleep_for(2 * wait_between_operations);
+    EagerLockGuard lock_1(eager_mutex, 1, 3, LockMode::READ);
+    thread_3_all_granted = lock_0 && lock_1;
+  });
+
+  thread_1.join();
+  thread_2.join();
+  thread_3.join();
+
+  // Transaction `3` is denied because of the SelectMaxPolicy.
+  ASSERT_TRUE(thread_2_all_granted);
+  ASSERT_FALSE(thread_3_all_granted);
+}
+
+TEST_F(GenericMutexTestFixture, TestNoWaitPolicy) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 1, NoWaitPolicy>
+      NoWaitGenericMutexType;
+  NoWaitGenericMutexType no_wait_mutex(contention_matrix);
+
+  ASSERT_TRUE(no_wait_mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_TRUE(no_wait_mutex.Lock(0, 2, LockMode::READ));
+  // Request in contention is denied right away
+  ASSERT_FALSE(no_wait_mutex.Lock(0, 3, LockMode::WRITE));
+  ASSERT_FALSE(no_wait_mutex.Convert(0, 1, LockMode::WRITE));
+  no_wait_mutex.Unlock(0, 1);
+  no_wait_mutex.Unlock(0, 2);
+  ASSERT_TRUE(no_wait_mutex.Lock(0, 3, LockMode::WRITE));
+  no_wait_mutex.Unlock(0, 3);
+}
+
+TEST_F(GenericMutexTestFixture, TestWaitDiePolicy) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 1, WaitDiePolicy>
+      WaitDieGenericMutexType;
+  WaitDieGenericMutexType wait_die_mutex(contention_matrix);
+
+  // Younger transaction dies instead of waiting on an older transaction
+  ASSERT_TRUE(wait_die_mutex.Lock(0, 2, LockMode::WRITE));
+  ASSERT_FALSE(wait_die_mutex.Lock(0, 3, LockMode::WRITE));
+
+  // Older transaction waits on a younger transaction
+  auto thread = std::thread([&]() {
+    std::this_thread::sleep_for(wait_between_operations);
+    wait_die_mutex.Unlock(0, 2);
+  });
+  ASSERT_TRUE(wait_die_mutex.Lock(0, 1, LockMode::WRITE));
+  thread.join();
+  wait_die_mutex.Unlock(0, 1);
+}
+
+TEST_F(GenericMutexTestFixture, TestWoundWaitPolicy) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 1, WoundWaitPolicy>
+      WoundWaitGenericMutexType;
+  WoundWaitGenericMutexType wound_wait_mutex(contention_matrix);
+
+  // Younger transaction `2` waits on older transaction `1` for record `1`,
+  // while older transaction `1` wounds transaction `2` holding record `0`.
+  bool thread_1_all_granted = false;
+  bool thread_2_all_granted = true;
+  auto thread_1 = std::thread([&]() {
+    bool granted_1 = wound_wait_mutex.Lock(1, 1, LockMode::WRITE);
+    std::this_thread::sleep_for(2 * wait_between_operations);
+    bool granted_0 = wound_wait_mutex.Lock(0, 1, LockMode::WRITE);
+    thread_1_all_granted = granted_1 && granted_0;
+    wound_wait_mutex.Unlock(0, 1);
+    wound_wait_mutex.Unlock(1, 1);
+  });
+  auto thread_2 = std::thread([&]() {
+    bool granted_0 = wound_wait_mutex.Lock(0, 2, LockMode::WRITE);
+    std::this_thread::sleep_for(wait_between_operations);
+    bool granted_1 = wound_wait_mutex.Lock(1, 2, LockMode::WRITE);
+    thread_2_all_granted = granted_0 && granted_1;
+    // The wounded transaction aborts by releasing its locks
+    if (granted_1) {
+      wound_wait_mutex.Unlock(1, 2);
+    }
+    wound_wait_mutex.Unlock(0, 2);
+  });
+
+  thread_1.join();
+  thread_2.join();
+
+  ASSERT_TRUE(thread_1_all_granted);
+  ASSERT_FALSE(thread_2_all_granted);
+
+  // Wounded transaction `4` holding record `0` is aborted at its next request
+  ASSERT_TRUE(wound_wait_mutex.Lock(0, 4, LockMode::WRITE));
+  bool thread_3_granted = false;
+  auto thread_3 = std::thread([&]() {
+    thread_3_granted = wound_wait_mutex.Lock(0, 3, LockMode::WRITE);
+    wound_wait_mutex.Unlock(0, 3);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(wound_wait_mutex.Lock(1, 4, LockMode::WRITE));
+  wound_wait_mutex.Unlock(0, 4);
+  thread_3.join();
+  ASSERT_TRUE(thread_3_granted);
+}
+
+TEST_F(GenericMutexTestFixture, TestWoundWaitPolicyReleasedWound) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 1, WoundWaitPolicy>
+      WoundWaitGenericMutexType;
+  WoundWaitGenericMutexType wound_wait_mutex(contention_matrix);
+
+  // Wounded transaction `4` aborts by unlocking instead of making a request.
+  // The wound does not outlive it.
+  ASSERT_TRUE(wound_wait_mutex.Lock(0, 4, LockMode::WRITE));
+  ASSERT_TRUE(wound_wait_mutex.Lock(1, 4, LockMode::READ));
+  auto thread = std::thread([&]() {
+    ASSERT_TRUE(wound_wait_mutex.Lock(0, 3, LockMode::WRITE));
+    wound_wait_mutex.Unlock(0, 3);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  wound_wait_mutex.Unlock(0, 4);
+  wound_wait_mutex.Unlock(1, 4);
+  thread.join();
+  ASSERT_TRUE(wound_wait_mutex.Lock(2, 4, LockMode::WRITE));
+
+  // Likewise when the wounded transaction unlocks all its locks at once
+  ASSERT_TRUE(wound_wait_mutex.Lock(0, 4, LockMode::WRITE));
+  thread = std::thread([&]() {
+    ASSERT_TRUE(wound_wait_mutex.Lock(0, 3, LockMode::WRITE));
+    wound_wait_mutex.Unlock(0, 3);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  wound_wait_mutex.UnlockAll(4);
+  thread.join();
+  ASSERT_TRUE(wound_wait_mutex.Lock(2, 4, LockMode::WRITE));
+  wound_wait_mutex.UnlockAll(4);
+}
+
+TEST_F(GenericMutexTestFixture, TestStaticContentionPolicy) {
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 1, NoWaitPolicy,
+                       ReadWriteContentionPolicy>
+      StaticGenericMutexType;
+  StaticGenericMutexType static_mutex;
+
+  ASSERT_TRUE(static_mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_TRUE(static_mutex.Lock(0, 2, LockMode::READ));
+  ASSERT_FALSE(static_mutex.Lock(0, 3, LockMode::WRITE));
+  static_mutex.Unlock(0, 1);
+  static_mutex.Unlock(0, 2);
+  ASSERT_TRUE(static_mutex.Lock(0, 3, LockMode::WRITE));
+  ASSERT_FALSE(static_mutex.Lock(0, 4, LockMode::READ));
+  static_mutex.Unlock(0, 3);
+}
+
+TEST_F(GenericMutexTestFixture, TestUncontendedHoldersMovedToQueue) {
+  // More readers than the uncontended holder set can keep
+  for (TransactionId transaction_id = 1; transaction_id <= 6;
+       ++transaction_id) {
+    ASSERT_TRUE(mutex.Lock(0, transaction_id, LockMode::READ));
+  }
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::READ));
+  mutex.Unlock(0, 1);
+
+  // Writer waits on the readers moved into the request queue
+  ASSERT_TRUE(mutex.Lock(1, 1, LockMode::READ));
+  ASSERT_TRUE(mutex.Lock(1, 2, LockMode::READ));
+  std::atomic<bool> granted = false;
+  auto thread = std::thread([&]() {
+    granted = mutex.Lock(1, 3, LockMode::WRITE);
+    mutex.Unlock(1, 3);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(granted);
+  mutex.Unlock(1, 1);
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(granted);
+  mutex.Unlock(1, 2);
+  thread.join();
+  ASSERT_TRUE(granted);
+
+  for (TransactionId transaction_id = 1; transaction_id <= 6;
+       ++transaction_id) {
+    mutex.Unlock(0, transaction_id);
+  }
+  ASSERT_TRUE(mutex.Lock(0, 7, LockMode::WRITE));
+  mutex.Unlock(0, 7);
+
+  // A single uncontended holder
+  GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 1, DetectOnTimeoutPolicy,
+               RuntimeContentionPolicy, NoIndexPolicy, 1>
+      single_holder_mutex(contention_matrix);
+  ASSERT_TRUE(single_holder_mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_FALSE(single_holder_mutex.TryLockAll({{0, LockMode::READ}}, 2));
+  ASSERT_TRUE(single_holder_mutex.TryLock(0, 2, LockMode::READ));
+  single_holder_mutex.UnlockAll(1);
+  single_holder_mutex.UnlockAll(2);
+}
+
+TEST_F(GenericMutexTestFixture, TestConvert) {
+  // Lock converted in place
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_EQ(mutex.Convert(0, 1, LockMode::WRITE), LockMode::WRITE);
+  ASSERT_EQ(mutex.Convert(0, 1, LockMode::READ), LockMode::WRITE);
+  ASSERT_FALSE(mutex.Convert(0, 2, LockMode::WRITE));
+  ASSERT_FALSE(mutex.Convert(1, 1, LockMode::WRITE));
+  mutex.Unlock(0, 1);
+
+  // Conversion to the supremum of the held and requested lock modes
+  enum class MultigranularityLockMode { IS, IX, S, SIX, X };
+  GenericMutex<RecordId, TransactionId, MultigranularityLockMode, 5, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 1, DetectOnTimeoutPolicy,
+               MultigranularityContentionPolicy>
+      multigranularity_mutex;
+  ASSERT_TRUE(multigranularity_mutex.Lock(0, 1, MultigranularityLockMode::IX));
+  ASSERT_TRUE(multigranularity_mutex.Lock(0, 2, MultigranularityLockMode::IS));
+  ASSERT_EQ(multigranularity_mutex.Convert(0, 1, MultigranularityLockMode::S),
+            MultigranularityLockMode::SIX);
+  multigranularity_mutex.Unlock(0, 1);
+  multigranularity_mutex.Unlock(0, 2);
+}
+
+TEST_F(GenericMutexTestFixture, TestConvertReleasedLock) {
+  // A guard whose lock is released while converting no longer owns it
+  LockGuard lock_guard(mutex, 0, 1, LockMode::READ);
+  ASSERT_TRUE(mutex.Lock(0, 2, LockMode::READ));
+  ASSERT_TRUE(mutex.HoldsLock(0, 1));
+  bool converted = true;
+  auto thread =
+      std::thread([&]() { converted = lock_guard.Convert(LockMode::WRITE); });
+  std::this_thread::sleep_for(wait_between_operations);
+  mutex.UnlockAll(1);
+  thread.join();
+  ASSERT_FALSE(converted);
+  ASSERT_FALSE(lock_guard.OwnsLock());
+  ASSERT_FALSE(mutex.HoldsLock(0, 1));
+
+  // The guard can lock the record again
+  ASSERT_TRUE(lock_guard.Lock());
+  ASSERT_TRUE(mutex.HoldsLock(0, 1));
+  mutex.UnlockAll(2);
+}
+
+TEST_F(GenericMutexTestFixture, TestConvertAheadOfNewRequests) {
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_TRUE(mutex.Lock(0, 2, LockMode::READ));
+
+  // Transaction `1` waits for transaction `2` to unlock before converting
+  std::atomic<bool> converted = false;
+  auto thread_1 = std::thread([&]() {
+    converted = bool(mutex.Convert(0, 1, LockMode::WRITE));
+    std::this_thread::sleep_for(2 * wait_between_operations);
+    mutex.Unlock(0, 1);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+
+  // New reader waits behind the pending conversion
+  std::atomic<bool> granted = false;
+  auto thread_3 = std::thread([&]() {
+    granted = mutex.Lock(0, 3, LockMode::READ);
+    mutex.Unlock(0, 3);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(converted);
+  ASSERT_FALSE(granted);
+
+  mutex.Unlock(0, 2);
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_TRUE(converted);
+  ASSERT_FALSE(granted);
+
+  thread_1.join();
+  thread_3.join();
+  ASSERT_TRUE(granted);
+}
+
+TEST_F(GenericMutexTestFixture, TestConversionDeadlock) {
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_TRUE(mutex.Lock(0, 2, LockMode::READ));
+
+  std::atomic<bool> converted = false;
+  auto thread = std::thread([&]() {
+    converted = bool(mutex.Convert(0, 1, LockMode::WRITE));
+    mutex.Unlock(0, 1);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+
+  // Both transactions converting would wait on each other. The second
+  // conversion is denied right away while its read lock is retained.
+  ASSERT_FALSE(mutex.Convert(0, 2, LockMode::WRITE));
+  ASSERT_FALSE(converted);
+  mutex.Unlock(0, 2);
+  thread.join();
+  ASSERT_TRUE(converted);
+}
+
+TEST_F(GenericMutexTestFixture, TestDowngrade) {
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_TRUE(mutex.Downgrade(0, 1, LockMode::READ));
+  ASSERT_FALSE(mutex.Downgrade(0, 1, LockMode::WRITE));
+  ASSERT_FALSE(mutex.Downgrade(0, 2, LockMode::READ));
+  ASSERT_EQ(mutex.Convert(0, 1, LockMode::WRITE), LockMode::WRITE);
+
+  // Readers waiting behind the writer are granted on downgrade, but not the
+  // writer waiting behind them.
+  std::atomic<size_t> readers_granted = 0;
+  std::vector<std::thread> readers;
+  for (TransactionId transaction_id = 2; transaction_id <= 3;
+       ++transaction_id) {
+    readers.emplace_back([&, transaction_id]() {
+      readers_granted += mutex.Lock(0, transaction_id, LockMode::READ);
+      std::this_thread::sleep_for(2 * wait_between_operations);
+      mutex.Unlock(0, transaction_id);
+    });
+  }
+  std::this_thread::sleep_for(wait_between_operations);
+  std::atomic<bool> writer_granted = false;
+  auto writer = std::thread([&]() {
+    writer_granted = mutex.Lock(0, 4, LockMode::WRITE);
+    mutex.Unlock(0, 4);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_EQ(readers_granted, 0);
+
+  ASSERT_TRUE(mutex.Downgrade(0, 1, LockMode::READ));
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_EQ(readers_granted, 2);
+  ASSERT_FALSE(writer_granted);
+
+  mutex.Unlock(0, 1);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  writer.join();
+  ASSERT_TRUE(writer_granted);
+}
+
+TEST_F(GenericMutexTestFixture, TestTryLock) {
+  ASSERT_TRUE(mutex.TryLock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.TryLock(0, 1, LockMode::WRITE));
+  ASSERT_FALSE(mutex.TryLock(0, 2, LockMode::READ));
+  mutex.Unlock(0, 1);
+  mutex.Unlock(0, 1);
+
+  // More readers than the uncontended holder set can keep
+  for (TransactionId transaction_id = 1; transaction_id <= 6;
+       ++transaction_id) {
+    ASSERT_TRUE(mutex.TryLock(0, transaction_id, LockMode::READ));
+  }
+  ASSERT_FALSE(mutex.TryLock(0, 7, LockMode::WRITE));
+
+  // Compatible request is not granted ahead of a waiting writer
+  std::atomic<bool> granted = false;
+  auto thread = std::thread([&]() {
+    granted = mutex.Lock(0, 7, LockMode::WRITE);
+    mutex.Unlock(0, 7);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(mutex.TryLock(0, 8, LockMode::READ));
+  for (TransactionId transaction_id = 1; transaction_id <= 6;
+       ++transaction_id) {
+    mutex.Unlock(0, transaction_id);
+  }
+  thread.join();
+  ASSERT_TRUE(granted);
+  ASSERT_TRUE(mutex.TryLock(0, 8, LockMode::READ));
+  mutex.Unlock(0, 8);
+}
+
+TEST_F(GenericMutexTestFixture, TestTimedLock) {
+  ASSERT_EQ(mutex.TryLockFor(0, 1, LockMode::READ, wait_between_operations),
+            LockStatus::GRANTED);
+  ASSERT_TRUE(mutex.Lock(1, 2, LockMode::WRITE));
+  ASSERT_EQ(mutex.TryLockFor(0, 2, LockMode::WRITE, wait_between_operations),
+            LockStatus::TIMEOUT);
+
+  // The expired request leaves no dependency behind, so transaction `1`
+  // waiting on transaction `2` is not mistaken for a deadlock.
+  std::atomic<bool> granted = false;
+  auto thread = std::thread([&]() {
+    granted = mutex.Lock(1, 1, LockMode::WRITE);
+    mutex.Unlock(1, 1);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  mutex.Unlock(1, 2);
+  thread.join();
+  ASSERT_TRUE(granted);
+
+  // Readers waiting behind an expired writer are granted right away
+  granted = false;
+  auto reader = std::thread([&]() {
+    std::this_thread::sleep_for(wait_between_operations);
+    granted = mutex.Lock(0, 3, LockMode::READ);
+  });
+  ASSERT_EQ(mutex.TryLockUntil(0, 2, LockMode::WRITE,
+                               std::chrono::steady_clock::now() +
+                                   2 * wait_between_operations),
+            LockStatus::TIMEOUT);
+  reader.join();
+  ASSERT_TRUE(granted);
+  mutex.Unlock(0, 3);
+  mutex.Unlock(0, 1);
+  ASSERT_EQ(mutex.TryLockFor(0, 2, LockMode::WRITE, wait_between_operations),
+            LockStatus::GRANTED);
+  mutex.Unlock(0, 2);
+
+  // Timed requests are denied on deadlock discovery
+  GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 1, DetectOnWaitPolicy>
+      detect_on_wait_mutex(contention_matrix);
+  ASSERT_TRUE(detect_on_wait_mutex.Lock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(detect_on_wait_mutex.Lock(1, 2, LockMode::WRITE));
+  ASSERT_EQ(detect_on_wait_mutex.TryLockFor(0, 2, LockMode::WRITE, 1ms),
+            LockStatus::TIMEOUT);
+  granted = false;
+  thread = std::thread([&]() {
+    granted = detect_on_wait_mutex.Lock(1, 1, LockMode::WRITE);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_EQ(detect_on_wait_mutex.TryLockFor(0, 2, LockMode::WRITE, 1s),
+            LockStatus::DENIED);
+  detect_on_wait_mutex.Unlock(1, 2);
+  thread.join();
+  ASSERT_TRUE(granted);
+  detect_on_wait_mutex.Unlock(0, 1);
+  detect_on_wait_mutex.Unlock(1, 1);
+}
+
+TEST_F(GenericMutexTestFixture, TestLockAsync) {
+  ASSERT_TRUE(mutex.LockAsync(0, 1, LockMode::WRITE).get());
+
+  // Waiting requests are completed by the unlocking thread. The callback is
+  // free to make requests on the mutex.
+  auto future = mutex.LockAsync(0, 2, LockMode::READ);
+  bool granted = false;
+  mutex.LockAsync(0, 3, LockMode::READ, [&](bool _granted) {
+    granted = _granted;
+    mutex.Unlock(0, 3);
+  });
+  ASSERT_EQ(future.wait_for(0ms), std::future_status::timeout);
+  ASSERT_FALSE(granted);
+  mutex.Unlock(0, 1);
+  ASSERT_EQ(future.wait_for(0ms), std::future_status::ready);
+  ASSERT_TRUE(future.get());
+  ASSERT_TRUE(granted);
+  mutex.Unlock(0, 2);
+
+  // Deadlocks closed by asynchronous requests are recovered right away
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.Lock(1, 2, LockMode::WRITE));
+  future = mutex.LockAsync(1, 1, LockMode::WRITE);
+  ASSERT_FALSE(mutex.LockAsync(0, 2, LockMode::WRITE).get());
+  ASSERT_EQ(future.wait_for(0ms), std::future_status::timeout);
+  mutex.Unlock(1, 2);
+  ASSERT_TRUE(future.get());
+  mutex.Unlock(0, 1);
+  mutex.Unlock(1, 1);
+
+  // Asynchronous requests denied to recover from a deadlock with a blocked
+  // transaction are completed while the transaction keeps waiting.
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.Lock(1, 2, LockMode::WRITE));
+  future = mutex.LockAsync(0, 2, LockMode::WRITE);
+  std::atomic<bool> blocked_granted = false;
+  auto thread = std::thread([&]() {
+    blocked_granted = mutex.Lock(1, 1, LockMode::WRITE);
+    mutex.Unlock(1, 1);
+  });
+  ASSERT_FALSE(future.get());
+  ASSERT_FALSE(blocked_granted);
+  mutex.Unlock(1, 2);
+  thread.join();
+  ASSERT_TRUE(blocked_granted);
+  mutex.Unlock(0, 1);
+}
+
+TEST_F(GenericMutexTestFixture, TestReentrantLock) {
+  // Uncontended lock acquired multiple times
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::READ));
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  mutex.Unlock(0, 1);
+  mutex.Unlock(0, 1);
+  ASSERT_FALSE(mutex.TryLock(0, 2, LockMode::READ));
+  mutex.Unlock(0, 1);
+  ASSERT_TRUE(mutex.TryLock(0, 2, LockMode::READ));
+
+  // A mode not covered by the held lock is denied
+  ASSERT_FALSE(mutex.Lock(0, 2, LockMode::WRITE));
+  ASSERT_TRUE(mutex.Lock(0, 2, LockMode::READ));
+
+  // Hold counts are carried over to the request queue
+  std::atomic<bool> granted = false;
+  auto thread = std::thread([&]() {
+    granted = mutex.Lock(0, 3, LockMode::WRITE);
+    mutex.Unlock(0, 3);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_TRUE(mutex.Lock(0, 2, LockMode::READ));
+  mutex.Unlock(0, 2);
+  mutex.Unlock(0, 2);
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(granted);
+  mutex.Unlock(0, 2);
+  thread.join();
+  ASSERT_TRUE(granted);
+}
+
+TEST_F(GenericMutexTestFixture, TestUnlockAll) {
+  // Uncontended and contended locks, some acquired multiple times
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.Lock(1, 1, LockMode::READ));
+  ASSERT_TRUE(mutex.Lock(1, 2, LockMode::READ));
+  ASSERT_TRUE(mutex.Lock(2, 2, LockMode::WRITE));
+  std::atomic<bool> granted = false;
+  auto thread = std::thread([&]() {
+    granted = mutex.Lock(0, 3, LockMode::WRITE);
+    mutex.Unlock(0, 3);
+  });
+  auto future = mutex.LockAsync(1, 3, LockMode::WRITE);
+
+  // Waiting requests of the transaction are denied
+  auto denied_future = mutex.LockAsync(2, 1, LockMode::READ);
+  mutex.UnlockAll(1);
+  ASSERT_FALSE(denied_future.get());
+  thread.join();
+  ASSERT_TRUE(granted);
+  ASSERT_EQ(future.wait_for(0ms), std::future_status::timeout);
+  mutex.UnlockAll(2);
+  ASSERT_TRUE(future.get());
+  ASSERT_TRUE(mutex.TryLock(2, 1, LockMode::WRITE));
+
+  // Nothing is left behind after all the locks are unlocked
+  mutex.UnlockAll(3);
+  mutex.UnlockAll(1);
+  mutex.UnlockAll(1);
+  ASSERT_TRUE(mutex.TryLock(0, 4, LockMode::WRITE));
+  ASSERT_TRUE(mutex.TryLock(1, 4, LockMode::WRITE));
+  ASSERT_TRUE(mutex.TryLock(2, 4, LockMode::WRITE));
+  mutex.UnlockAll(4);
+}
+
+TEST_F(GenericMutexTestFixture, TestUnlockAllBlockedTransaction) {
+  GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 1, DetectOnTimeoutPolicy,
+               RuntimeContentionPolicy, NoIndexPolicy>
+      unindexed_mutex(contention_matrix);
+  auto test = [&](auto& _mutex) {
+    ASSERT_TRUE(_mutex.Lock(0, 1, LockMode::READ));
+    ASSERT_TRUE(_mutex.Lock(0, 2, LockMode::READ));
+    ASSERT_TRUE(_mutex.Lock(1, 3, LockMode::WRITE));
+
+    // Threads of the transaction blocked on a conversion and on a lock request
+    // are woken up with their requests denied.
+    std::optional<LockMode> converted_mode = LockMode::READ;
+    bool granted = true;
+    auto convert_thread = std::thread(
+        [&]() { converted_mode = _mutex.Convert(0, 1, LockMode::WRITE); });
+    auto lock_thread =
+        std::thread([&]() { granted = _mutex.Lock(1, 1, LockMode::READ); });
+    std::this_thread::sleep_for(wait_between_operations);
+    _mutex.UnlockAll(1);
+    convert_thread.join();
+    lock_thread.join();
+    ASSERT_FALSE(converted_mode);
+    ASSERT_FALSE(granted);
+
+    // Nothing is left behind for the transaction
+    ASSERT_EQ(_mutex.Convert(0, 2, LockMode::WRITE), LockMode::WRITE);
+    _mutex.UnlockAll(2);
+    _mutex.UnlockAll(3);
+    ASSERT_TRUE(_mutex.TryLock(0, 4, LockMode::WRITE));
+    ASSERT_TRUE(_mutex.TryLock(1, 4, LockMode::WRITE));
+    _mutex.UnlockAll(4);
+  };
+  test(mutex);
+  test(unindexed_mutex);
+}
+
+TEST_F(GenericMutexTestFixture, TestLockAll) {
+  // Requests granted right away, including records locked twice
+  ASSERT_EQ(mutex.LockAll({{2, LockMode::READ},
+                           {0, LockMode::WRITE},
+                           {1, LockMode::READ},
+                           {0, LockMode::READ}},
+                          1),
+            std::vector<bool>({true, true, true, true}));
+  ASSERT_TRUE(mutex.TryLock(1, 2, LockMode::READ));
+
+  // Requests after a conflicting request are made once it is granted
+  std::atomic<bool> done = false;
+  std::vector<bool> granted;
+  auto thread = std::thread([&]() {
+    granted = mutex.LockAll(
+        {{0, LockMode::READ}, {1, LockMode::READ}, {3, LockMode::WRITE}}, 2);
+    done = true;
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(done);
+  ASSERT_TRUE(mutex.TryLock(3, 3, LockMode::READ));
+  mutex.Unlock(3, 3);
+  mutex.UnlockAll(1);
+  thread.join();
+  ASSERT_EQ(granted, std::vector<bool>({true, true, true}));
+
+  // Requests after a denied conflicting request are not made
+  ASSERT_TRUE(mutex.Lock(4, 1, LockMode::WRITE));
+  auto future = mutex.LockAsync(3, 1, LockMode::WRITE);
+  ASSERT_EQ(mutex.LockAll({{4, LockMode::WRITE}, {5, LockMode::WRITE}}, 2),
+            std::vector<bool>({false, false}));
+  mutex.UnlockAll(2);
+  ASSERT_TRUE(future.get());
+  mutex.UnlockAll(1);
+}
+
+TEST_F(GenericMutexTestFixture, TestLockAllCrossingRecords) {
+  // Records `0` and `2` are mapped to a different shard than records `1` and
+  // `3`.
+  GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 2>
+      sharded_mutex(contention_matrix);
+  GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 2, NoWaitPolicy>
+      no_wait_mutex(contention_matrix);
+  const std::vector<std::pair<RecordId, LockMode>> requests_1 = {
+      {0, LockMode::WRITE},
+      {1, LockMode::WRITE},
+      {2, LockMode::WRITE},
+      {3, LockMode::WRITE}};
+  const std::vector<std::pair<RecordId, LockMode>> requests_2 = {
+      {3, LockMode::WRITE},
+      {2, LockMode::WRITE},
+      {1, LockMode::WRITE},
+      {0, LockMode::WRITE}};
+  const std::vector<bool> all_granted(4, true);
+
+  // Transaction 1 blocks on record `0` before locking the free records after
+  // it, and record `3` is freed before transaction 2 locks the records in
+  // reverse order. Both transactions block on record `0` holding nothing, so
+  // they do not deadlock once it is unlocked.
+  ASSERT_TRUE(sharded_mutex.Lock(0, 3, LockMode::WRITE));
+  ASSERT_TRUE(sharded_mutex.Lock(3, 4, LockMode::WRITE));
+  std::vector<bool> granted_1;
+  std::vector<bool> granted_2;
+  auto thread_1 = std::thread([&]() {
+    granted_1 = sharded_mutex.LockAll(requests_1, 1);
+    sharded_mutex.UnlockAll(1);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_TRUE(sharded_mutex.TryLock(1, 5, LockMode::WRITE));
+  sharded_mutex.UnlockAll(5);
+  sharded_mutex.UnlockAll(4);
+  auto thread_2 = std::thread([&]() {
+    granted_2 = sharded_mutex.LockAll(requests_2, 2);
+    sharded_mutex.UnlockAll(2);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_TRUE(sharded_mutex.TryLock(3, 5, LockMode::WRITE));
+  sharded_mutex.UnlockAll(5);
+  sharded_mutex.UnlockAll(3);
+  thread_1.join();
+  thread_2.join();
+  ASSERT_EQ(granted_1, all_granted);
+  ASSERT_EQ(granted_2, all_granted);
+
+  // The locks granted are a prefix of the requests in canonical order, so no
+  // record is held past a denied request.
+  ASSERT_TRUE(no_wait_mutex.Lock(0, 3, LockMode::WRITE));
+  ASSERT_EQ(no_wait_mutex.LockAll(requests_1, 1), std::vector<bool>(4, false));
+  ASSERT_EQ(no_wait_mutex.LockAll(requests_2, 2), std::vector<bool>(4, false));
+  ASSERT_TRUE(no_wait_mutex.TryLock(1, 4, LockMode::WRITE));
+  ASSERT_TRUE(no_wait_mutex.TryLock(2, 4, LockMode::WRITE));
+  ASSERT_TRUE(no_wait_mutex.TryLock(3, 4, LockMode::WRITE));
+  no_wait_mutex.UnlockAll(3);
+  no_wait_mutex.UnlockAll(4);
+}
+
+TEST_F(GenericMutexTestFixture, TestLockAllCollidingRecords) {
+  GenericMutex<CollidingRecordId, TransactionId, LockMode, 2, timeout_ms,
+               SelectMaxPolicy<TransactionId>, 1, NoWaitPolicy>
+      colliding_mutex(contention_matrix);
+
+  // Records with colliding hashes are locked in the order of their
+  // identifiers, whatever the order of the requests.
+  ASSERT_TRUE(colliding_mutex.Lock({0}, 3, LockMode::WRITE));
+  ASSERT_EQ(colliding_mutex.LockAll(
+                {{{1}, LockMode::WRITE}, {{0}, LockMode::WRITE}}, 1),
+            std::vector<bool>(2, false));
+  ASSERT_FALSE(colliding_mutex.TryLockAll(
+      {{{1}, LockMode::WRITE}, {{0}, LockMode::WRITE}}, 1));
+  ASSERT_TRUE(colliding_mutex.TryLock({1}, 2, LockMode::WRITE));
+  colliding_mutex.UnlockAll(2);
+  colliding_mutex.UnlockAll(3);
+  ASSERT_EQ(colliding_mutex.LockAll(
+                {{{1}, LockMode::WRITE}, {{0}, LockMode::WRITE}}, 1),
+            std::vector<bool>(2, true));
+  colliding_mutex.UnlockAll(1);
+}
+
+TEST_F(GenericMutexTestFixture, TestTryLockAll) {
+  ASSERT_TRUE(mutex.TryLockAll(
+      {{0, LockMode::READ}, {1, LockMode::WRITE}, {0, LockMode::READ}}, 1));
+
+  // Nothing is acquired if any lock can not be granted right away
+  ASSERT_TRUE(mutex.Lock(2, 2, LockMode::READ));
+  ASSERT_FALSE(mutex.TryLockAll(
+      {{0, LockMode::READ}, {2, LockMode::READ}, {1, LockMode::READ}}, 2));
+  ASSERT_FALSE(mutex.TryLockAll({{0, LockMode::READ}, {3, LockMode::WRITE},
+                                 {3, LockMode::WRITE}, {2, LockMode::WRITE}},
+                                1));
+  ASSERT_TRUE(mutex.TryLock(3, 3, LockMode::WRITE));
+  ASSERT_FALSE(mutex.TryLock(0, 3, LockMode::WRITE));
+  mutex.Unlock(0, 1);
+  ASSERT_FALSE(mutex.TryLock(0, 3, LockMode::WRITE));
+  mutex.Unlock(0, 1);
+  ASSERT_TRUE(mutex.TryLock(0, 3, LockMode::WRITE));
+
+  // Failed attempts leave no waiting request behind
+  ASSERT_FALSE(mutex.TryLockAll({{2, LockMode::READ}, {1, LockMode::READ}}, 2));
+  mutex.Unlock(1, 1);
+  ASSERT_TRUE(mutex.TryLockAll({{2, LockMode::READ}, {1, LockMode::READ}}, 2));
+  mutex.UnlockAll(2);
+  mutex.UnlockAll(3);
+
+  // Locks overflowing the holder set of an uncontended record are not granted
+  for (TransactionId transaction_id = 4; transaction_id <= 7;
+       ++transaction_id) {
+    ASSERT_TRUE(mutex.Lock(4, transaction_id, LockMode::READ));
+  }
+  ASSERT_FALSE(mutex.TryLockAll({{0, LockMode::READ}, {4, LockMode::READ}}, 8));
+  ASSERT_TRUE(mutex.TryLock(0, 1, LockMode::WRITE));
+  ASSERT_TRUE(mutex.TryLock(4, 8, LockMode::READ));
+  for (TransactionId transaction_id = 1; transaction_id <= 8;
+       ++transaction_id) {
+    mutex.UnlockAll(transaction_id);
+  }
+
+  // Records spanning multiple shards
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, timeout_ms,
+                       SelectMaxPolicy<TransactionId>, 2>
+      ShardedGenericMutexType;
+  ShardedGenericMutexType sharded_mutex(contention_matrix);
+  ASSERT_TRUE(sharded_mutex.Lock(3, 2, LockMode::WRITE));
+  ASSERT_FALSE(sharded_mutex.TryLockAll(
+      {{3, LockMode::READ}, {0, LockMode::READ}, {1, LockMode::READ}}, 1));
+  ASSERT_TRUE(sharded_mutex.TryLock(0, 2, LockMode::WRITE));
+  sharded_mutex.UnlockAll(2);
+  ASSERT_TRUE(sharded_mutex.TryLockAll(
+      {{3, LockMode::READ}, {0, LockMode::READ}, {1, LockMode::READ}}, 1));
+  sharded_mutex.UnlockAll(1);
+}
+
+TEST_F(GenericMutexTestFixture, TestTransaction) {
+  auto transaction = mutex.BeginTransaction(1);
+  ASSERT_EQ(transaction.Id(), 1);
+  ASSERT_TRUE(transaction.Lock(0, LockMode::WRITE));
+  ASSERT_TRUE(transaction.Lock(0, LockMode::READ));
+  ASSERT_TRUE(transaction.TryLock(1, LockMode::READ));
+  ASSERT_FALSE(transaction.Lock(1, LockMode::WRITE));
+
+  // Each acquisition is released once
+  transaction.Unlock(0);
+  ASSERT_FALSE(mutex.TryLock(0, 2, LockMode::READ));
+  transaction.Unlock(0);
+  transaction.Unlock(0);
+  ASSERT_TRUE(mutex.TryLock(0, 2, LockMode::READ));
+
+  // Waiting requests are granted once the handle unlocks all its locks
+  ASSERT_TRUE(transaction.Lock(2, LockMode::WRITE));
+  std::atomic<bool> granted = false;
+  auto thread = std::thread([&]() {
+    auto other = mutex.BeginTransaction(3);
+    granted = other.Lock(2, LockMode::READ) && other.Lock(1, LockMode::WRITE);
+  });
+  std::this_thread::sleep_for(wait_between_operations);
+  ASSERT_FALSE(granted);
+  transaction.UnlockAll();
+  thread.join();
+  ASSERT_TRUE(granted);
+
+  // The locks held by the handle are released on destruction
+  {
+    auto other = std::move(transaction);
+    ASSERT_TRUE(other.Lock(1, LockMode::READ));
+    ASSERT_TRUE(other.Lock(2, LockMode::READ));
+  }
+  mutex.Unlock(0, 2);
+  ASSERT_TRUE(mutex.TryLock(0, 4, LockMode::WRITE));
+  ASSERT_TRUE(mutex.TryLock(1, 4, LockMode::WRITE));
+  ASSERT_TRUE(mutex.TryLock(2, 4, LockMode::WRITE));
+  mutex.UnlockAll(4);
+
+  // The transaction locks records by its identifier once its handle is gone
+  ASSERT_TRUE(mutex.TryLock(0, 1, LockMode::WRITE));
+  mutex.UnlockAll(1);
+  transaction = mutex.BeginTransaction(1);
+  ASSERT_TRUE(transaction.Lock(0, LockMode::WRITE));
+}
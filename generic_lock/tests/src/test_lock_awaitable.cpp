@@ -0,0 +1,145 @@
+// Copyright 2021 Ketan Goyal
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @brief Unit Test Lock Awaitable
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <generic_lock/generic_mutex.hpp>
+#include <generic_lock/lock_awaitable.hpp>
+
+// The awaitables are only available with C++20 coroutine support.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+using namespace gl;
+
+class LockAwaitableTestFixture : public ::testing::Test {
+ protected:
+  typedef size_t RecordId;
+  typedef size_t TransactionId;
+
+  // ----------------------------
+  enum class LockMode { READ, WRITE };
+  const ContentionMatrix<2> contention_matrix = {
+      {{{false, true}}, {{true, true}}}};
+
+  typedef GenericMutex<RecordId, TransactionId, LockMode, 2, 1>
+      GenericMutexType;
+  GenericMutexType mutex = {contention_matrix};
+  // ----------------------------
+
+  // ----------------------------
+  // Coroutine started eagerly and destroyed once it runs to completion.
+  struct Task {
+    struct promise_type {
+      Task get_return_object() { return {}; }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+    };
+  };
+
+  // Executor queueing the coroutines to resume till they are run.
+  struct QueueExecutor {
+    std::vector<std::coroutine_handle<>>* queue;
+    void operator()(std::coroutine_handle<> handle) const {
+      queue->push_back(handle);
+    }
+  };
+  // ----------------------------
+};
+
+TEST_F(LockAwaitableTestFixture, TestLockAwaitable) {
+  std::vector<bool> granted;
+  auto lock = [&](RecordId record_id, TransactionId transaction_id,
+                  LockMode mode) -> Task {
+    granted.push_back(
+        co_await LockAwaitable(mutex, record_id, transaction_id, mode));
+  };
+
+  // Uncontended requests complete without suspending.
+  lock(0, 1, LockMode::WRITE);
+  ASSERT_EQ(granted, std::vector<bool>({true}));
+
+  // Waiting requests are resumed on the unlocking thread.
+  lock(0, 2, LockMode::READ);
+  ASSERT_EQ(granted.size(), 1);
+  mutex.Unlock(0, 1);
+  ASSERT_EQ(granted, std::vector<bool>({true, true}));
+
+  // Denied requests are resumed with `false`.
+  ASSERT_TRUE(mutex.Lock(1, 1, LockMode::WRITE));
+  lock(1, 2, LockMode::WRITE);
+  lock(0, 1, LockMode::WRITE);
+  ASSERT_EQ(granted, std::vector<bool>({true, true, false}));
+  mutex.Unlock(0, 2);
+  mutex.Unlock(1, 1);
+  ASSERT_EQ(granted, std::vector<bool>({true, true, false, true}));
+  mutex.Unlock(0, 1);
+}
+
+TEST_F(LockAwaitableTestFixture, TestGenericLockAwaitable) {
+  std::vector<std::coroutine_handle<>> queue;
+  std::vector<bool> owned;
+  std::vector<bool> denied;
+  auto lock = [&](RecordId record_id, TransactionId transaction_id,
+                  LockMode mode) -> Task {
+    auto guard = co_await GenericLockAwaitable(
+        mutex, record_id, transaction_id, mode, QueueExecutor{&queue});
+    owned.push_back(guard.OwnsLock());
+    denied.push_back(guard.IsDenied());
+  };
+  auto resume_next = [&]() {
+    auto handle = queue.front();
+    queue.erase(queue.begin());
+    handle.resume();
+  };
+
+  // The guard unlocks the record once the coroutine completes.
+  ASSERT_TRUE(mutex.Lock(0, 1, LockMode::WRITE));
+  lock(0, 2, LockMode::WRITE);
+  lock(0, 3, LockMode::WRITE);
+  mutex.Unlock(0, 1);
+  ASSERT_TRUE(owned.empty());
+  ASSERT_EQ(queue.size(), 1);
+  resume_next();
+  ASSERT_EQ(owned, std::vector<bool>({true}));
+  ASSERT_EQ(queue.size(), 1);
+  resume_next();
+  ASSERT_EQ(owned, std::vector<bool>({true, true}));
+  ASSERT_EQ(denied, std::vector<bool>({false, false}));
+  ASSERT_TRUE(mutex.TryLock(0, 1, LockMode::WRITE));
+
+  // Denied requests result in a denied guard.
+  ASSERT_TRUE(mutex.Lock(1, 2, LockMode::WRITE));
+  lock(1, 1, LockMode::WRITE);
+  lock(0, 2, LockMode::WRITE);
+  ASSERT_EQ(owned, std::vector<bool>({true, true, false}));
+  ASSERT_EQ(denied, std::vector<bool>({false, false, true}));
+  mutex.Unlock(1, 2);
+  ASSERT_EQ(queue.size(), 1);
+  resume_next();
+  ASSERT_EQ(owned, std::vector<bool>({true, true, false, true}));
+  mutex.Unlock(0, 1);
+}
+
+#endif